@@ -307,6 +307,11 @@ time_zone::time_zone(const detail::string_t& s)
     }
 }
 
+// civil-edit-start
+// The rules of a zone in the southern hemisphere start daylight saving time
+// later in the year than they end it, so `start` and `end` below are then in
+// the opposite order. Local lookups are built on the sys lookup, which keeps
+// them right for both orders.
 template <class Duration>
 date::sys_info
 time_zone::get_info(date::sys_time<Duration> st) const
@@ -326,132 +331,119 @@ time_zone::get_info(date::sys_time<Duration> st) const
     using std::chrono::minutes;
     sys_info r{};
     r.offset = offset_;
+    r.abbrev = std_abbrev_;
     if (start_rule_.ok())
     {
         auto y = year_month_day{floor<days>(st)}.year();
-        auto start = sys_seconds{(start_rule_(y) - offset_).time_since_epoch()};
-        auto end   = sys_seconds{(end_rule_(y) - (offset_ + save_)).time_since_epoch()};
-        if (start <= st && st < end)
+        auto start_of = [this](year yy)
         {
-            r.begin = start;
-            r.end = end;
-            r.offset += save_;
-            r.save = ceil<minutes>(save_);
-            r.abbrev = dst_abbrev_;
+            return sys_seconds{(start_rule_(yy) - offset_).time_since_epoch()};
+        };
+        auto end_of = [this](year yy)
+        {
+            return sys_seconds{(end_rule_(yy) - (offset_ + save_)).time_since_epoch()};
+        };
+        auto start = start_of(y);
+        auto end = end_of(y);
+        bool dst;
+        if (start < end)
+        {
+            if (st < start)
+            {
+                r.begin = end_of(y-years{1});
+                r.end = start;
+                dst = false;
+            }
+            else if (st < end)
+            {
+                r.begin = start;
+                r.end = end;
+                dst = true;
+            }
+            else
+            {
+                r.begin = end;
+                r.end = start_of(y+years{1});
+                dst = false;
+            }
         }
-        else if (st < start)
+        else
         {
-            r.begin = sys_seconds{(end_rule_(y-years{1}) -
-                                   (offset_ + save_)).time_since_epoch()};
-            r.end = start;
-            r.abbrev = std_abbrev_;
+            if (st < end)
+            {
+                r.begin = start_of(y-years{1});
+                r.end = end;
+                dst = true;
+            }
+            else if (st < start)
+            {
+                r.begin = end;
+                r.end = start;
+                dst = false;
+            }
+            else
+            {
+                r.begin = start;
+                r.end = end_of(y+years{1});
+                dst = true;
+            }
         }
-        else  // st >= end
+        if (dst)
         {
-            r.begin = end;
-            r.end = sys_seconds{(start_rule_(y+years{1}) - offset_).time_since_epoch()};
-            r.abbrev = std_abbrev_;
+            r.offset += save_;
+            r.save = ceil<minutes>(save_);
+            r.abbrev = dst_abbrev_;
         }
     }
     else  //  constant offset
     {
         r.begin = sys_days{year::min()/January/1};
         r.end   = sys_days{year::max()/December/last};
-        r.abbrev = std_abbrev_;
     }
     return r;
 }
 
+// A local time maps back to itself through the offset of the interval found
+// for it with either of the two offsets the zone has. That holds for both of
+// them in an overlap, and for neither in a gap.
 template <class Duration>
 date::local_info
 time_zone::get_info(date::local_time<Duration> tp) const
 {
     using date::local_info;
-    using date::year_month_day;
-    using date::days;
-    using date::sys_days;
     using date::sys_seconds;
-    using date::years;
-    using date::year;
-    using date::ceil;
-    using date::January;
-    using date::December;
-    using date::last;
+    using date::floor;
     using std::chrono::seconds;
-    using std::chrono::minutes;
     local_info r{};
-    using date::floor;
-    if (start_rule_.ok())
+    auto ltp = floor<seconds>(tp);
+    auto std_info = get_info(sys_seconds{(ltp - offset_).time_since_epoch()});
+    if (!start_rule_.ok() || save_ == seconds{0})
     {
-        auto y = year_month_day{floor<days>(tp)}.year();
-        auto start = sys_seconds{(start_rule_(y) - offset_).time_since_epoch()};
-        auto end   = sys_seconds{(end_rule_(y) - (offset_ + save_)).time_since_epoch()};
-        auto utcs = sys_seconds{floor<seconds>(tp - offset_).time_since_epoch()};
-        auto utcd = sys_seconds{floor<seconds>(tp - (offset_ + save_)).time_since_epoch()};
-        if ((utcs < start) != (utcd < start))
-        {
-            r.first.begin = sys_seconds{(end_rule_(y-years{1}) -
-                                         (offset_ + save_)).time_since_epoch()};
-            r.first.end = start;
-            r.first.offset = offset_;
-            r.first.abbrev = std_abbrev_;
-            r.second.begin = start;
-            r.second.end = end;
-            r.second.abbrev = dst_abbrev_;
-            r.second.offset = offset_ + save_;
-            r.second.save = ceil<minutes>(save_);
-            r.result = save_ > seconds{0} ? local_info::nonexistent
-                                          : local_info::ambiguous;
-        }
-        else if ((utcs < end) != (utcd < end))
-        {
-            r.first.begin = start;
-            r.first.end = end;
-            r.first.offset = offset_ + save_;
-            r.first.save = ceil<minutes>(save_);
-            r.first.abbrev = dst_abbrev_;
-            r.second.begin = end;
-            r.second.end = sys_seconds{(start_rule_(y+years{1}) -
-                                        offset_).time_since_epoch()};
-            r.second.abbrev = std_abbrev_;
-            r.second.offset = offset_;
-            r.result = save_ > seconds{0} ? local_info::ambiguous
-                                          : local_info::nonexistent;
-        }
-        else if (utcs < start)
-        {
-            r.first.begin = sys_seconds{(end_rule_(y-years{1}) -
-                                   (offset_ + save_)).time_since_epoch()};
-            r.first.end = start;
-            r.first.offset = offset_;
-            r.first.abbrev = std_abbrev_;
-        }
-        else if (utcs < end)
-        {
-            r.first.begin = start;
-            r.first.end = end;
-            r.first.offset = offset_ + save_;
-            r.first.save = ceil<minutes>(save_);
-            r.first.abbrev = dst_abbrev_;
-        }
-        else
-        {
-            r.first.begin = end;
-            r.first.end = sys_seconds{(start_rule_(y+years{1}) -
-                                       offset_).time_since_epoch()};
-            r.first.abbrev = std_abbrev_;
-            r.first.offset = offset_;
-        }
+        r.first = std_info;
+        return r;
     }
-    else  //  constant offset
+    auto dst_info = get_info(sys_seconds{(ltp - (offset_ + save_)).time_since_epoch()});
+    bool std_ok = std_info.offset == offset_;
+    bool dst_ok = dst_info.offset == offset_ + save_;
+    if (std_ok != dst_ok)
+    {
+        r.first = std_ok ? std_info : dst_info;
+        return r;
+    }
+    if (std_info.begin < dst_info.begin)
+    {
+        r.first = std_info;
+        r.second = dst_info;
+    }
+    else
     {
-        r.first.begin = sys_days{year::min()/January/1};
-        r.first.end   = sys_days{year::max()/December/last};
-        r.first.abbrev = std_abbrev_;
-        r.first.offset = offset_;
+        r.first = dst_info;
+        r.second = std_info;
     }
+    r.result = std_ok ? local_info::ambiguous : local_info::nonexistent;
     return r;
 }
+// civil-edit-stop
 
 template <class Duration>
 date::sys_time<typename std::common_type<Duration, std::chrono::seconds>::type>
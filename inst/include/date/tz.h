@@ -134,6 +134,15 @@ static_assert(HAS_REMOTE_API == 0 ? AUTO_DOWNLOAD == 0 : true,
 #  endif
 #endif
 
+// civil-edit-start
+#if USE_OS_TZDB
+namespace Posix
+{
+class time_zone;
+}
+#endif  // USE_OS_TZDB
+// civil-edit-stop
+
 namespace date
 {
 
@@ -770,11 +779,25 @@ namespace detail
 #  else  // !USE_OS_TZDB
     struct zonelet;
     class Rule;
+    // civil-edit-start
+    struct expanded_info;
+    struct expanded_local_info;
+    // civil-edit-stop
 #  endif  // !USE_OS_TZDB
 }
 
 #endif  // !defined(_MSC_VER) || (_MSC_VER >= 1900)
 
+// civil-edit-start
+#if !USE_OS_TZDB
+namespace detail
+{
+    struct tzdb_cache;
+    struct tzdb_index;
+}
+#endif  // !USE_OS_TZDB
+// civil-edit-stop
+
 class time_zone
 {
 private:
@@ -782,8 +805,44 @@ private:
 #if USE_OS_TZDB
     std::vector<detail::transition>      transitions_;
     std::vector<detail::expanded_ttinfo> ttinfos_;
+    // civil-edit-start
+    // The POSIX TZ string from the footer of a version 2+ TZif file. It
+    // covers instants past the last transition in the file, which otherwise
+    // would stay in that transition's interval forever.
+    std::shared_ptr<const Posix::time_zone> posix_;
+    // civil-edit-stop
 #else  // !USE_OS_TZDB
     std::vector<detail::zonelet>         zonelets_;
+    // civil-edit-start
+    // Zones indexed from the binary cache are only named up front. Their
+    // zonelets, and the rules those reference, are read from `index_` at
+    // `offset_` the first time the zone is used.
+    std::vector<detail::Rule>                 rules_;
+    std::shared_ptr<const detail::tzdb_index> index_;
+    std::uint32_t                             offset_ = 0;
+
+    // Transitions in the years 1900 through 2100, expanded from the rules
+    // when the zone is loaded. The last entry only marks the end of the one
+    // before it. Lookups in `[expanded_begin_, expanded_end_)` are a binary
+    // search over these instead of a walk through the rules.
+    std::vector<detail::expanded_info>        expanded_;
+    std::vector<std::string>                  abbrevs_;
+    sys_seconds                               expanded_begin_{};
+    sys_seconds                               expanded_end_{};
+
+    // The same table keyed on local time, where each boundary is the start
+    // of a unique, nonexistent or ambiguous run of local times. Local lookups
+    // in the window are a single binary search over these.
+    std::vector<detail::expanded_local_info>  expanded_local_;
+
+    // The begins and offsets of the table again, in Eytzinger (breadth first)
+    // order and padded to a complete tree of `eytzinger_depth_` levels, for
+    // the batched searches of `get_offsets()`. Node `i` has children `2i` and
+    // `2i + 1`, and node 0 is unused.
+    std::vector<std::int64_t>                 eytzinger_begins_;
+    std::vector<std::int32_t>                 eytzinger_offsets_;
+    unsigned                                  eytzinger_depth_ = 0;
+    // civil-edit-stop
 #endif  // !USE_OS_TZDB
     std::unique_ptr<std::once_flag>      adjusted_;
 
@@ -821,6 +880,24 @@ public:
 
 #if !USE_OS_TZDB
     DATE_API void add(const std::string& s);
+
+    // civil-edit-start
+    // Abbreviations are interned into a small table when the zone is loaded.
+    // This `get_info()` sets `abbrev_id` to the id of the result's
+    // abbreviation in that table and leaves `abbrev` itself empty, so that
+    // nothing is copied. Outside the expanded window `abbrev_id` is
+    // `no_abbrev` and `abbrev` is filled in as usual. `abbrev()` returns the
+    // interned string for an id, which lives as long as the zone.
+    static const std::uint32_t no_abbrev = static_cast<std::uint32_t>(-1);
+    DATE_API sys_info           get_info(sys_seconds tp, std::uint32_t& abbrev_id) const;
+    DATE_API const std::string& abbrev(std::uint32_t id) const;
+
+    // Offsets of a block of instants, which need not be sorted. Instants in
+    // the expanded window are looked up by branch free searches run several
+    // at a time, the rest one at a time through `get_info()`.
+    DATE_API void get_offsets(const sys_seconds* tps, std::size_t size,
+                              std::chrono::seconds* offsets) const;
+    // civil-edit-stop
 #endif  // !USE_OS_TZDB
 
 private:
@@ -844,10 +921,27 @@ private:
     DATE_API void
     load_data(std::istream& inf, std::int32_t tzh_leapcnt, std::int32_t tzh_timecnt,
                                  std::int32_t tzh_typecnt, std::int32_t tzh_charcnt);
+    // civil-edit-start
+    DATE_API void load_footer(std::istream& inf);
+    // civil-edit-stop
 #else  // !USE_OS_TZDB
     DATE_API sys_info   get_info_impl(sys_seconds tp, int timezone) const;
     DATE_API void adjust_infos(const std::vector<detail::Rule>& rules);
     DATE_API void parse_info(std::istream& in);
+
+    // civil-edit-start
+    friend struct detail::tzdb_cache;
+    time_zone(std::string name, std::shared_ptr<const detail::tzdb_index> index,
+              std::uint32_t offset);
+    DATE_API void load_infos();
+    DATE_API void expand_infos();
+    DATE_API void expand_local_infos();
+    DATE_API void expand_eytzinger(std::size_t i, std::size_t& k);
+    DATE_API sys_info   get_rule_info(sys_seconds tp, int timezone) const;
+    DATE_API std::size_t get_expanded_index(sys_seconds tp) const;
+    DATE_API sys_info   get_expanded_info(std::size_t i, bool with_abbrev = true) const;
+    DATE_API local_info get_expanded_info(local_seconds tp) const;
+    // civil-edit-stop
 #endif  // !USE_OS_TZDB
 };
 
@@ -857,6 +951,19 @@ inline
 time_zone::time_zone(time_zone&& src)
     : name_(std::move(src.name_))
     , zonelets_(std::move(src.zonelets_))
+    // civil-edit-start
+    , rules_(std::move(src.rules_))
+    , index_(std::move(src.index_))
+    , offset_(src.offset_)
+    , expanded_(std::move(src.expanded_))
+    , abbrevs_(std::move(src.abbrevs_))
+    , expanded_begin_(src.expanded_begin_)
+    , expanded_end_(src.expanded_end_)
+    , expanded_local_(std::move(src.expanded_local_))
+    , eytzinger_begins_(std::move(src.eytzinger_begins_))
+    , eytzinger_offsets_(std::move(src.eytzinger_offsets_))
+    , eytzinger_depth_(src.eytzinger_depth_)
+    // civil-edit-stop
     , adjusted_(std::move(src.adjusted_))
     {}
 
@@ -866,6 +973,19 @@ time_zone::operator=(time_zone&& src)
 {
     name_ = std::move(src.name_);
     zonelets_ = std::move(src.zonelets_);
+    // civil-edit-start
+    rules_ = std::move(src.rules_);
+    index_ = std::move(src.index_);
+    offset_ = src.offset_;
+    expanded_ = std::move(src.expanded_);
+    abbrevs_ = std::move(src.abbrevs_);
+    expanded_begin_ = src.expanded_begin_;
+    expanded_end_ = src.expanded_end_;
+    expanded_local_ = std::move(src.expanded_local_);
+    eytzinger_begins_ = std::move(src.eytzinger_begins_);
+    eytzinger_offsets_ = std::move(src.eytzinger_offsets_);
+    eytzinger_depth_ = src.eytzinger_depth_;
+    // civil-edit-stop
     adjusted_ = std::move(src.adjusted_);
     return *this;
 }
@@ -975,6 +1095,12 @@ public:
     friend bool operator< (const time_zone_link& x, const time_zone_link& y) {return x.name_ < y.name_;}
 
     friend DATE_API std::ostream& operator<<(std::ostream& os, const time_zone_link& x);
+
+    // civil-edit-start
+private:
+    friend struct detail::tzdb_cache;
+    time_zone_link() = default;
+    // civil-edit-stop
 };
 
 using link = time_zone_link;
@@ -991,6 +1117,13 @@ class leap_second
 private:
     sys_seconds date_;
 
+    // civil-edit-start
+#if !USE_OS_TZDB
+    friend struct detail::tzdb_cache;
+    leap_second() = default;
+#endif  // !USE_OS_TZDB
+    // civil-edit-stop
+
 public:
 #if USE_OS_TZDB
     DATE_API explicit leap_second(const sys_seconds& s, detail::undocumented);
@@ -1299,6 +1432,19 @@ DATE_API tzdb_list& get_tzdb_list();
 DATE_API const tzdb& reload_tzdb();
 DATE_API void        set_install(const std::string& install);
 
+// civil-edit-start
+// Parses the text database found at `install` and writes it to `path` in the
+// binary format that `init_tzdb()` prefers over the text files when a current
+// copy sits next to them.
+DATE_API void        write_tzdb_cache(const std::string& install, const std::string& path);
+
+// Turns the local time index of the expanded tables on or off. With it off,
+// local lookups search the table itself, as they do for zones whose
+// transitions are too close together to index. For tests of that path.
+DATE_API void        set_local_index(bool enabled);
+
+// civil-edit-stop
+
 #endif  // !USE_OS_TZDB
 
 #if HAS_REMOTE_API
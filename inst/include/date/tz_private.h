@@ -121,6 +121,10 @@ public:
 
     friend std::istream& operator>>(std::istream& is, MonthDayTime& x);
     friend std::ostream& operator<<(std::ostream& os, const MonthDayTime& x);
+
+    // civil-edit-start
+    friend struct tzdb_cache;
+    // civil-edit-stop
 };
 
 // A Rule specifies one or more set of datetimes without using an offset.
@@ -183,6 +187,10 @@ public:
 
     friend std::ostream& operator<<(std::ostream& os, const Rule& r);
 
+    // civil-edit-start
+    friend struct tzdb_cache;
+    // civil-edit-stop
+
 private:
     date::day day() const;
     date::month month() const;
@@ -256,6 +264,29 @@ struct zonelet
     zonelet& operator=(const zonelet&) = delete;
 };
 
+// civil-edit-start
+// An entry of a zone's pre-expanded transition table. It is in effect from
+// `begin_` until the `begin_` of the next entry.
+struct expanded_info
+{
+    sys_seconds   begin_;
+    std::int32_t  offset_;  // seconds
+    std::int32_t  save_;    // minutes
+    std::uint32_t abbrev_;  // index into `time_zone::abbrevs_`
+};
+
+// An entry of a zone's local time index, built from the expanded transition
+// table. Every local time from `begin_` until the `begin_` of the next entry
+// has the same `local_info`. It is unique in entry `index_` of the table, or
+// nonexistent or ambiguous between entries `index_` and `index_ + 1`.
+struct expanded_local_info
+{
+    local_seconds begin_;
+    std::uint32_t index_;
+    std::int32_t  result_;  // a `local_info` result
+};
+// civil-edit-stop
+
 #else  // USE_OS_TZDB
 
 struct ttinfo
@@ -5,17 +5,18 @@
 #include "resolve.h"
 #include "civil-rcrd.h"
 #include "check.h"
+#include "ymd.h"
 
 // -----------------------------------------------------------------------------
 
-static civil_writable_rcrd adjust_local_days(const civil_rcrd& x,
+static civil_writable_rcrd adjust_local_days(SEXP x,
                                              const cpp11::integers& value,
                                              const enum day_nonexistent& day_nonexistent_val,
                                              const r_ssize& size,
                                              const enum adjuster& adjuster_val);
 
 [[cpp11::register]]
-civil_writable_rcrd adjust_local_days_cpp(const civil_rcrd& x,
+civil_writable_rcrd adjust_local_days_cpp(SEXP x,
                                           const cpp11::integers& value,
                                           const cpp11::strings& day_nonexistent,
                                           const cpp11::integers& size,
@@ -35,34 +36,32 @@ adjust_local_days_switch(const date::year_month_day& ymd,
                          const int& value,
                          const enum adjuster& adjuster_val);
 
-static civil_writable_rcrd adjust_local_days(const civil_rcrd& x,
+static civil_writable_rcrd adjust_local_days(SEXP x,
                                              const cpp11::integers& value,
                                              const enum day_nonexistent& day_nonexistent_val,
                                              const r_ssize& size,
                                              const enum adjuster& adjuster_val) {
-  civil_writable_rcrd out = civil_rcrd_clone(x);
-  civil_rcrd_recycle(out, size);
+  civil_writable_rcrd out = civil_rcrd_clone(x, size);
 
-  int* p_days = civil_rcrd_days_deref(out);
-  int* p_time_of_day = civil_rcrd_time_of_day_deref(out);
-  int* p_nanos_of_second = civil_rcrd_nanos_of_second_deref(out);
+  civil_rcrd_field days(out, 0);
+  civil_rcrd_field time_of_day(out, 1);
+  civil_rcrd_field nanos_of_second(out, 2);
 
   const bool recycle_value = civil_is_scalar(value);
 
   for (r_ssize i = 0; i < size; ++i) {
-    int elt_days = p_days[i];
+    int elt_days = days[i];
     int elt_value = recycle_value ? value[0] : value[i];
 
     if (elt_days == r_int_na) {
       continue;
     }
     if (elt_value == r_int_na) {
-      civil_rcrd_assign_missing(i, p_days, p_time_of_day, p_nanos_of_second);
+      civil_rcrd_assign_missing(i, days, time_of_day, nanos_of_second);
       continue;
     }
 
-    date::local_days elt_lday{date::days{elt_days}};
-    date::year_month_day elt_ymd{elt_lday};
+    date::year_month_day elt_ymd = days_to_ymd_one(elt_days);
 
     date::year_month_day out_ymd = adjust_local_days_switch(
       elt_ymd,
@@ -74,9 +73,9 @@ static civil_writable_rcrd adjust_local_days(const civil_rcrd& x,
       i,
       day_nonexistent_val,
       out_ymd,
-      p_days,
-      p_time_of_day,
-      p_nanos_of_second
+      days,
+      time_of_day,
+      nanos_of_second
     );
   }
 
@@ -140,13 +139,13 @@ adjust_local_days_switch(const date::year_month_day& ymd,
 
 // -----------------------------------------------------------------------------
 
-static civil_writable_rcrd adjust_local_time_of_day(const civil_rcrd& x,
+static civil_writable_rcrd adjust_local_time_of_day(SEXP x,
                                                     const cpp11::integers& value,
                                                     const r_ssize& size,
                                                     const enum adjuster& adjuster_val);
 
 [[cpp11::register]]
-civil_writable_rcrd adjust_local_time_of_day_cpp(const civil_rcrd& x,
+civil_writable_rcrd adjust_local_time_of_day_cpp(SEXP x,
                                                  const cpp11::integers& value,
                                                  const cpp11::integers& size,
                                                  const cpp11::strings& adjuster) {
@@ -167,28 +166,27 @@ adjust_local_time_of_day_switch(const date::hh_mm_ss<std::chrono::seconds>& hms,
                                 const int& value,
                                 const enum adjuster& adjuster_val);
 
-static civil_writable_rcrd adjust_local_time_of_day(const civil_rcrd& x,
+static civil_writable_rcrd adjust_local_time_of_day(SEXP x,
                                                     const cpp11::integers& value,
                                                     const r_ssize& size,
                                                     const enum adjuster& adjuster_val) {
-  civil_writable_rcrd out = civil_rcrd_clone(x);
-  civil_rcrd_recycle(out, size);
+  civil_writable_rcrd out = civil_rcrd_clone(x, size);
 
-  int* p_days = civil_rcrd_days_deref(out);
-  int* p_time_of_day = civil_rcrd_time_of_day_deref(out);
-  int* p_nanos_of_second = civil_rcrd_nanos_of_second_deref(out);
+  civil_rcrd_field days(out, 0);
+  civil_rcrd_field time_of_day(out, 1);
+  civil_rcrd_field nanos_of_second(out, 2);
 
   const bool recycle_value = civil_is_scalar(value);
 
   for (r_ssize i = 0; i < size; ++i) {
-    int elt_time_of_day = p_time_of_day[i];
+    int elt_time_of_day = time_of_day[i];
     int elt_value = recycle_value ? value[0] : value[i];
 
     if (elt_time_of_day == r_int_na) {
       continue;
     }
     if (elt_value == r_int_na) {
-      civil_rcrd_assign_missing(i, p_days, p_time_of_day, p_nanos_of_second);
+      civil_rcrd_assign_missing(i, days, time_of_day, nanos_of_second);
       continue;
     }
 
@@ -201,7 +199,7 @@ static civil_writable_rcrd adjust_local_time_of_day(const civil_rcrd& x,
       adjuster_val
     );
 
-    p_time_of_day[i] = out_tod.count();
+    time_of_day.set(i, out_tod.count());
   }
 
   return out;
@@ -253,13 +251,13 @@ adjust_local_time_of_day_switch(const date::hh_mm_ss<std::chrono::seconds>& hms,
 
 // -----------------------------------------------------------------------------
 
-static civil_writable_rcrd adjust_local_nanos_of_second(const civil_rcrd& x,
+static civil_writable_rcrd adjust_local_nanos_of_second(SEXP x,
                                                         const cpp11::integers& value,
                                                         const r_ssize& size,
                                                         const enum adjuster& adjuster_val);
 
 [[cpp11::register]]
-civil_writable_rcrd adjust_local_nanos_of_second_cpp(const civil_rcrd& x,
+civil_writable_rcrd adjust_local_nanos_of_second_cpp(SEXP x,
                                                      const cpp11::integers& value,
                                                      const cpp11::integers& size,
                                                      const cpp11::strings& adjuster) {
@@ -280,28 +278,27 @@ adjust_local_nanos_of_second_switch(const std::chrono::nanoseconds& x,
                                     const int& value,
                                     const enum adjuster& adjuster_val);
 
-static civil_writable_rcrd adjust_local_nanos_of_second(const civil_rcrd& x,
+static civil_writable_rcrd adjust_local_nanos_of_second(SEXP x,
                                                         const cpp11::integers& value,
                                                         const r_ssize& size,
                                                         const enum adjuster& adjuster_val) {
-  civil_writable_rcrd out = civil_rcrd_clone(x);
-  civil_rcrd_recycle(out, size);
+  civil_writable_rcrd out = civil_rcrd_clone(x, size);
 
-  int* p_days = civil_rcrd_days_deref(out);
-  int* p_time_of_day = civil_rcrd_time_of_day_deref(out);
-  int* p_nanos_of_second = civil_rcrd_nanos_of_second_deref(out);
+  civil_rcrd_field days(out, 0);
+  civil_rcrd_field time_of_day(out, 1);
+  civil_rcrd_field nanos_of_second(out, 2);
 
   const bool recycle_value = civil_is_scalar(value);
 
   for (r_ssize i = 0; i < size; ++i) {
-    int elt_nanos_of_second = p_nanos_of_second[i];
+    int elt_nanos_of_second = nanos_of_second[i];
     int elt_value = recycle_value ? value[0] : value[i];
 
     if (elt_nanos_of_second == r_int_na) {
       continue;
     }
     if (elt_value == r_int_na) {
-      civil_rcrd_assign_missing(i, p_days, p_time_of_day, p_nanos_of_second);
+      civil_rcrd_assign_missing(i, days, time_of_day, nanos_of_second);
       continue;
     }
 
@@ -313,7 +310,7 @@ static civil_writable_rcrd adjust_local_nanos_of_second(const civil_rcrd& x,
       adjuster_val
     );
 
-    p_nanos_of_second[i] = out_nanos.count();
+    nanos_of_second.set(i, out_nanos.count());
   }
 
   return out;
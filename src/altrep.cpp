@@ -0,0 +1,284 @@
+#include "altrep.h"
+#include "utils.h"
+
+#if HAS_ALTREP
+#include <R_ext/Altrep.h>
+#endif
+
+// -----------------------------------------------------------------------------
+
+/*
+ * A compact repeat stores a list of its value (a length 1 vector) and its size
+ * (a double, so long vectors fit) in `data1`. `data2` is `NULL` until the
+ * vector is expanded, and the expanded vector after that.
+ */
+
+#if HAS_ALTREP
+
+static R_altrep_class_t compact_rep_int_class;
+static R_altrep_class_t compact_rep_chr_class;
+
+static inline SEXP compact_rep_value(SEXP x) {
+  return VECTOR_ELT(R_altrep_data1(x), 0);
+}
+static inline r_ssize compact_rep_size(SEXP x) {
+  return static_cast<r_ssize>(REAL(VECTOR_ELT(R_altrep_data1(x), 1))[0]);
+}
+static inline SEXP compact_rep_expanded(SEXP x) {
+  return R_altrep_data2(x);
+}
+static inline bool compact_rep_is_expanded(SEXP x) {
+  return compact_rep_expanded(x) != R_NilValue;
+}
+
+static SEXP new_compact_rep(R_altrep_class_t cls, SEXP value, r_ssize size) {
+  SEXP data1 = PROTECT(Rf_allocVector(VECSXP, 2));
+  SET_VECTOR_ELT(data1, 0, value);
+  SET_VECTOR_ELT(data1, 1, Rf_ScalarReal(static_cast<double>(size)));
+
+  SEXP out = R_new_altrep(cls, data1, R_NilValue);
+
+  UNPROTECT(1);
+  return out;
+}
+
+static R_xlen_t compact_rep_length(SEXP x) {
+  return compact_rep_size(x);
+}
+
+static Rboolean compact_rep_inspect(SEXP x,
+                                    int pre,
+                                    int deep,
+                                    int pvec,
+                                    void (*inspect_subtree)(SEXP, int, int, int)) {
+  Rprintf(
+    "civil_compact_rep (size = %.0f, expanded = %s)\n",
+    static_cast<double>(compact_rep_size(x)),
+    compact_rep_is_expanded(x) ? "TRUE" : "FALSE"
+  );
+  return TRUE;
+}
+
+/*
+ * Duplicating an unexpanded compact repeat gives another one, so the shallow
+ * duplicates that kernels make of their input don't expand it. Returning
+ * `NULL` falls back to R's default, which copies the expanded vector.
+ */
+static SEXP compact_rep_duplicate(SEXP x, Rboolean deep) {
+  if (compact_rep_is_expanded(x)) {
+    return NULL;
+  }
+
+  R_altrep_class_t cls = TYPEOF(x) == INTSXP ? compact_rep_int_class : compact_rep_chr_class;
+
+  return new_compact_rep(cls, compact_rep_value(x), compact_rep_size(x));
+}
+
+// -----------------------------------------------------------------------------
+
+static SEXP compact_rep_int_expand(SEXP x) {
+  SEXP out = compact_rep_expanded(x);
+
+  if (out != R_NilValue) {
+    return out;
+  }
+
+  const r_ssize size = compact_rep_size(x);
+  const int value = INTEGER(compact_rep_value(x))[0];
+
+  out = PROTECT(Rf_allocVector(INTSXP, size));
+  int* p_out = INTEGER(out);
+
+  for (r_ssize i = 0; i < size; ++i) {
+    p_out[i] = value;
+  }
+
+  R_set_altrep_data2(x, out);
+
+  UNPROTECT(1);
+  return out;
+}
+
+static void* compact_rep_int_dataptr(SEXP x, Rboolean writeable) {
+  return INTEGER(compact_rep_int_expand(x));
+}
+
+static const void* compact_rep_int_dataptr_or_null(SEXP x) {
+  if (compact_rep_is_expanded(x)) {
+    return INTEGER(compact_rep_expanded(x));
+  } else {
+    return NULL;
+  }
+}
+
+static int compact_rep_int_elt(SEXP x, R_xlen_t i) {
+  if (compact_rep_is_expanded(x)) {
+    return INTEGER(compact_rep_expanded(x))[i];
+  } else {
+    return INTEGER(compact_rep_value(x))[0];
+  }
+}
+
+static R_xlen_t compact_rep_int_get_region(SEXP x, R_xlen_t start, R_xlen_t n, int* buf) {
+  const r_ssize size = compact_rep_size(x);
+  const r_ssize n_out = start + n > size ? size - start : n;
+
+  if (compact_rep_is_expanded(x)) {
+    const int* p_x = INTEGER(compact_rep_expanded(x)) + start;
+
+    for (r_ssize i = 0; i < n_out; ++i) {
+      buf[i] = p_x[i];
+    }
+  } else {
+    const int value = INTEGER(compact_rep_value(x))[0];
+
+    for (r_ssize i = 0; i < n_out; ++i) {
+      buf[i] = value;
+    }
+  }
+
+  return n_out;
+}
+
+static int compact_rep_int_no_na(SEXP x) {
+  return !compact_rep_is_expanded(x) && INTEGER(compact_rep_value(x))[0] != r_int_na;
+}
+
+// -----------------------------------------------------------------------------
+
+static SEXP compact_rep_chr_expand(SEXP x) {
+  SEXP out = compact_rep_expanded(x);
+
+  if (out != R_NilValue) {
+    return out;
+  }
+
+  const r_ssize size = compact_rep_size(x);
+  SEXP value = STRING_ELT(compact_rep_value(x), 0);
+
+  out = PROTECT(Rf_allocVector(STRSXP, size));
+
+  for (r_ssize i = 0; i < size; ++i) {
+    SET_STRING_ELT(out, i, value);
+  }
+
+  R_set_altrep_data2(x, out);
+
+  UNPROTECT(1);
+  return out;
+}
+
+static void* compact_rep_chr_dataptr(SEXP x, Rboolean writeable) {
+  return const_cast<SEXP*>(STRING_PTR_RO(compact_rep_chr_expand(x)));
+}
+
+static const void* compact_rep_chr_dataptr_or_null(SEXP x) {
+  if (compact_rep_is_expanded(x)) {
+    return STRING_PTR_RO(compact_rep_expanded(x));
+  } else {
+    return NULL;
+  }
+}
+
+static SEXP compact_rep_chr_elt(SEXP x, R_xlen_t i) {
+  if (compact_rep_is_expanded(x)) {
+    return STRING_ELT(compact_rep_expanded(x), i);
+  } else {
+    return STRING_ELT(compact_rep_value(x), 0);
+  }
+}
+
+static void compact_rep_chr_set_elt(SEXP x, R_xlen_t i, SEXP value) {
+  SET_STRING_ELT(compact_rep_chr_expand(x), i, value);
+}
+
+static int compact_rep_chr_no_na(SEXP x) {
+  return !compact_rep_is_expanded(x) && STRING_ELT(compact_rep_value(x), 0) != r_chr_na;
+}
+
+#endif
+
+// -----------------------------------------------------------------------------
+
+// [[ include("altrep.h") ]]
+SEXP civil_compact_rep_int(int value, r_ssize size) {
+#if HAS_ALTREP
+  SEXP x_value = PROTECT(Rf_ScalarInteger(value));
+  SEXP out = new_compact_rep(compact_rep_int_class, x_value, size);
+  UNPROTECT(1);
+  return out;
+#else
+  SEXP out = PROTECT(Rf_allocVector(INTSXP, size));
+  int* p_out = INTEGER(out);
+
+  for (r_ssize i = 0; i < size; ++i) {
+    p_out[i] = value;
+  }
+
+  UNPROTECT(1);
+  return out;
+#endif
+}
+
+// [[ include("altrep.h") ]]
+SEXP civil_compact_rep_chr(SEXP value, r_ssize size) {
+#if HAS_ALTREP
+  SEXP x_value = PROTECT(Rf_ScalarString(value));
+  SEXP out = new_compact_rep(compact_rep_chr_class, x_value, size);
+  UNPROTECT(1);
+  return out;
+#else
+  SEXP out = PROTECT(Rf_allocVector(STRSXP, size));
+
+  for (r_ssize i = 0; i < size; ++i) {
+    SET_STRING_ELT(out, i, value);
+  }
+
+  UNPROTECT(1);
+  return out;
+#endif
+}
+
+// [[ include("altrep.h") ]]
+const int* civil_compact_rep_int_value(SEXP x) {
+#if HAS_ALTREP
+  if (!ALTREP(x) || !R_altrep_inherits(x, compact_rep_int_class)) {
+    return NULL;
+  }
+  if (compact_rep_is_expanded(x)) {
+    return NULL;
+  }
+  return INTEGER(compact_rep_value(x));
+#else
+  return NULL;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+
+[[cpp11::init]]
+void civil_init_altrep(DllInfo* dll) {
+#if HAS_ALTREP
+  compact_rep_int_class = R_make_altinteger_class("civil_compact_rep_int", "civil", dll);
+
+  R_set_altrep_Length_method(compact_rep_int_class, compact_rep_length);
+  R_set_altrep_Inspect_method(compact_rep_int_class, compact_rep_inspect);
+  R_set_altrep_Duplicate_method(compact_rep_int_class, compact_rep_duplicate);
+  R_set_altvec_Dataptr_method(compact_rep_int_class, compact_rep_int_dataptr);
+  R_set_altvec_Dataptr_or_null_method(compact_rep_int_class, compact_rep_int_dataptr_or_null);
+  R_set_altinteger_Elt_method(compact_rep_int_class, compact_rep_int_elt);
+  R_set_altinteger_Get_region_method(compact_rep_int_class, compact_rep_int_get_region);
+  R_set_altinteger_No_NA_method(compact_rep_int_class, compact_rep_int_no_na);
+
+  compact_rep_chr_class = R_make_altstring_class("civil_compact_rep_chr", "civil", dll);
+
+  R_set_altrep_Length_method(compact_rep_chr_class, compact_rep_length);
+  R_set_altrep_Inspect_method(compact_rep_chr_class, compact_rep_inspect);
+  R_set_altrep_Duplicate_method(compact_rep_chr_class, compact_rep_duplicate);
+  R_set_altvec_Dataptr_method(compact_rep_chr_class, compact_rep_chr_dataptr);
+  R_set_altvec_Dataptr_or_null_method(compact_rep_chr_class, compact_rep_chr_dataptr_or_null);
+  R_set_altstring_Elt_method(compact_rep_chr_class, compact_rep_chr_elt);
+  R_set_altstring_Set_elt_method(compact_rep_chr_class, compact_rep_chr_set_elt);
+  R_set_altstring_No_NA_method(compact_rep_chr_class, compact_rep_chr_no_na);
+#endif
+}
@@ -0,0 +1,42 @@
+#ifndef CIVIL_ALTREP_H
+#define CIVIL_ALTREP_H
+
+#include "civil.h"
+#include <Rversion.h>
+#include <R_ext/Rdynload.h>
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Compact repeats are ALTREP vectors holding one value repeated `size` times.
+ * They are what recycling a scalar field or scalar names gives, so
+ * broadcasting a scalar against a long vector doesn't allocate the repeated
+ * copies up front.
+ *
+ * Reading an element never expands a compact repeat. Asking for its data
+ * pointer, which is what writing through `INTEGER()` does, expands it once
+ * into a regular vector that the ALTREP object keeps from then on.
+ *
+ * ALTREP needs R 3.6.0 or later. On older versions, these allocate the full
+ * vector like ordinary recycling does.
+ */
+
+#if R_VERSION >= R_Version(3, 6, 0)
+#define HAS_ALTREP 1
+#else
+#define HAS_ALTREP 0
+#endif
+
+SEXP civil_compact_rep_int(int value, r_ssize size);
+SEXP civil_compact_rep_chr(SEXP value, r_ssize size);
+
+/*
+ * Returns a pointer to the one value of `x` if it is a compact repeat that
+ * hasn't been expanded yet, or `NULL` otherwise. Kernels read such a field
+ * with a stride of 0.
+ */
+const int* civil_compact_rep_int_value(SEXP x);
+
+void civil_init_altrep(DllInfo* dll);
+
+#endif
@@ -4,37 +4,37 @@
 #include "conversion.h"
 #include "resolve.h"
 #include "civil-rcrd.h"
+#include "ymd.h"
 
 // -----------------------------------------------------------------------------
 
-static civil_writable_rcrd add_years_or_months_local(const civil_rcrd& x,
+static civil_writable_rcrd add_years_or_months_local(SEXP x,
                                                      const cpp11::integers& n,
                                                      const enum day_nonexistent& day_nonexistent_val,
                                                      const enum unit& unit_val,
                                                      const r_ssize& size) {
-  civil_writable_rcrd out = civil_rcrd_clone(x);
-  civil_rcrd_recycle(out, size);
+  civil_writable_rcrd out = civil_rcrd_clone(x, size);
 
-  int* p_days = civil_rcrd_days_deref(out);
-  int* p_time_of_day = civil_rcrd_time_of_day_deref(out);
-  int* p_nanos_of_second = civil_rcrd_nanos_of_second_deref(out);
+  civil_rcrd_field days(out, 0);
+  civil_rcrd_field time_of_day(out, 1);
+  civil_rcrd_field nanos_of_second(out, 2);
 
   const bool recycle_n = civil_is_scalar(n);
+  const int* p_n = civil_int_deref_const(n);
 
   for (r_ssize i = 0; i < size; ++i) {
-    int elt_days = p_days[i];
-    int elt_n = recycle_n ? n[0] : n[i];
+    int elt_days = days[i];
+    int elt_n = p_n[recycle_n ? 0 : i];
 
     if (elt_days == r_int_na) {
       continue;
     }
     if (elt_n == r_int_na) {
-      civil_rcrd_assign_missing(i, p_days, p_time_of_day, p_nanos_of_second);
+      civil_rcrd_assign_missing(i, days, time_of_day, nanos_of_second);
       continue;
     }
 
-    date::local_days elt_lday{date::days{elt_days}};
-    date::year_month_day elt_ymd{elt_lday};
+    date::year_month_day elt_ymd = days_to_ymd_one(elt_days);
 
     date::year_month_day out_ymd;
 
@@ -48,9 +48,9 @@ static civil_writable_rcrd add_years_or_months_local(const civil_rcrd& x,
       i,
       day_nonexistent_val,
       out_ymd,
-      p_days,
-      p_time_of_day,
-      p_nanos_of_second
+      days,
+      time_of_day,
+      nanos_of_second
     );
   }
 
@@ -58,7 +58,7 @@ static civil_writable_rcrd add_years_or_months_local(const civil_rcrd& x,
 }
 
 [[cpp11::register]]
-civil_writable_rcrd add_years_or_months_local_cpp(const civil_rcrd& x,
+civil_writable_rcrd add_years_or_months_local_cpp(SEXP x,
                                                   const cpp11::integers& n,
                                                   const cpp11::strings& day_nonexistent,
                                                   const cpp11::strings& unit,
@@ -72,45 +72,45 @@ civil_writable_rcrd add_years_or_months_local_cpp(const civil_rcrd& x,
 
 // -----------------------------------------------------------------------------
 
-static civil_writable_rcrd add_weeks_or_days_local(const civil_rcrd& x,
+static civil_writable_rcrd add_weeks_or_days_local(SEXP x,
                                                    const cpp11::integers& n,
                                                    const enum unit& unit_val,
                                                    const r_ssize& size) {
-  civil_writable_rcrd out = civil_rcrd_clone(x);
-  civil_rcrd_recycle(out, size);
+  civil_writable_rcrd out = civil_rcrd_clone(x, size);
 
-  int* p_days = civil_rcrd_days_deref(out);
-  int* p_time_of_day = civil_rcrd_time_of_day_deref(out);
-  int* p_nanos_of_second = civil_rcrd_nanos_of_second_deref(out);
+  civil_rcrd_field days(out, 0);
+  civil_rcrd_field time_of_day(out, 1);
+  civil_rcrd_field nanos_of_second(out, 2);
 
   const bool recycle_n = civil_is_scalar(n);
+  const int* p_n = civil_int_deref_const(n);
+
+  // Handle weeks as a period of 7 days
+  const int days_per_unit = (unit_val == unit::week) ? 7 : 1;
 
   for (r_ssize i = 0; i < size; ++i) {
-    int elt_days = p_days[i];
-    int elt_n = recycle_n ? n[0] : n[i];
+    int elt_days = days[i];
+    int elt_n = p_n[recycle_n ? 0 : i];
 
     if (elt_days == r_int_na) {
       continue;
     }
     if (elt_n == r_int_na) {
-      civil_rcrd_assign_missing(i, p_days, p_time_of_day, p_nanos_of_second);
+      civil_rcrd_assign_missing(i, days, time_of_day, nanos_of_second);
       continue;
     }
 
-    // Handle weeks as a period of 7 days
-    elt_n = (unit_val == unit::week) ? elt_n * 7 : elt_n;
-
     date::local_days elt_lday{date::days{elt_days}};
-    date::local_days out_lday = elt_lday + date::days{elt_n};
+    date::local_days out_lday = elt_lday + date::days{elt_n * days_per_unit};
 
-    p_days[i] = out_lday.time_since_epoch().count();
+    days.set(i, out_lday.time_since_epoch().count());
   }
 
   return out;
 }
 
 [[cpp11::register]]
-civil_writable_rcrd add_weeks_or_days_local_cpp(const civil_rcrd& x,
+civil_writable_rcrd add_weeks_or_days_local_cpp(SEXP x,
                                                 const cpp11::integers& n,
                                                 const cpp11::strings& unit,
                                                 const cpp11::integers& size) {
@@ -122,76 +122,6 @@ civil_writable_rcrd add_weeks_or_days_local_cpp(const civil_rcrd& x,
 
 // -----------------------------------------------------------------------------
 
-static civil_writable_rcrd add_hours_or_minutes_or_seconds(const civil_rcrd& x,
-                                                           const cpp11::integers& n,
-                                                           const enum unit& unit_val,
-                                                           const r_ssize& size) {
-  civil_writable_rcrd out = civil_rcrd_clone(x);
-  civil_rcrd_recycle(out, size);
-
-  int* p_days = civil_rcrd_days_deref(out);
-  int* p_time_of_day = civil_rcrd_time_of_day_deref(out);
-  int* p_nanos_of_second = civil_rcrd_nanos_of_second_deref(out);
-
-  const bool recycle_n = civil_is_scalar(n);
-
-  for (r_ssize i = 0; i < size; ++i) {
-    int elt_days = p_days[i];
-    int elt_time_of_day = p_time_of_day[i];
-    int elt_n = recycle_n ? n[0] : n[i];
-
-    if (elt_days == r_int_na) {
-      continue;
-    }
-    if (elt_n == r_int_na) {
-      civil_rcrd_assign_missing(i, p_days, p_time_of_day, p_nanos_of_second);
-      continue;
-    }
-
-    std::chrono::seconds elt_tod{elt_time_of_day};
-
-    date::sys_days elt_sday{date::days{elt_days}};
-    date::sys_seconds elt_ssec_floor{elt_sday};
-
-    date::sys_seconds elt_ssec = elt_ssec_floor + elt_tod;
-
-    std::chrono::seconds elt_chrono_n;
-
-    if (unit_val == unit::hour) {
-      elt_chrono_n = std::chrono::hours{elt_n};
-    } else if (unit_val == unit::minute) {
-      elt_chrono_n = std::chrono::minutes{elt_n};
-    } else if (unit_val == unit::second) {
-      elt_chrono_n = std::chrono::seconds{elt_n};
-    }
-
-    date::sys_seconds out_ssec = elt_ssec + elt_chrono_n;
-
-    date::sys_days out_sday = date::floor<date::days>(out_ssec);
-    date::sys_seconds out_ssec_floor{out_sday};
-
-    std::chrono::seconds out_tod{out_ssec - out_ssec_floor};
-
-    p_days[i] = out_sday.time_since_epoch().count();
-    p_time_of_day[i] = out_tod.count();
-  }
-
-  return out;
-}
-
-[[cpp11::register]]
-civil_writable_rcrd add_hours_or_minutes_or_seconds_cpp(const civil_rcrd& x,
-                                                        const cpp11::integers& n,
-                                                        const cpp11::strings& unit,
-                                                        const cpp11::integers& size) {
-  enum unit unit_val = parse_unit(unit);
-  r_ssize c_size = size[0];
-
-  return add_hours_or_minutes_or_seconds(x, n, unit_val, c_size);
-}
-
-// -----------------------------------------------------------------------------
-
 /*
  * Handle sub-second arithmetic specially by avoiding conversion from
  * nano_datetime fields to std::chrono::nanosecond. We try to support
@@ -225,7 +155,7 @@ inline
 fields_datetime plus_time_of_day(const date::days& days,
                                  const std::chrono::seconds& time_of_day,
                                  const std::chrono::seconds& n) {
-  static std::chrono::seconds::rep sec_in_day = 86400;
+  const std::chrono::seconds::rep sec_in_day = 86400;
   std::chrono::seconds::rep count = time_of_day.count() + n.count();
   date::days overflow{(count >= 0 ? count : count - (sec_in_day - 1)) / sec_in_day};
   std::chrono::seconds out_time_of_day{count - overflow.count() * sec_in_day};
@@ -239,7 +169,7 @@ fields_nano_datetime plus_nanos_of_second(const date::days& days,
                                           const std::chrono::seconds& time_of_day,
                                           const std::chrono::nanoseconds& nanos_of_second,
                                           const std::chrono::nanoseconds& n) {
-  static std::chrono::nanoseconds::rep nanos_in_sec = 1000000000;
+  const std::chrono::nanoseconds::rep nanos_in_sec = 1000000000;
   std::chrono::nanoseconds::rep count = nanos_of_second.count() + n.count();
   std::chrono::seconds overflow{(count >= 0 ? count : count - (nanos_in_sec - 1)) / nanos_in_sec};
   std::chrono::nanoseconds out_nanos_of_second{count - overflow.count() * nanos_in_sec};
@@ -247,60 +177,186 @@ fields_nano_datetime plus_nanos_of_second(const date::days& days,
   return {fdt.days, fdt.time_of_day, out_nanos_of_second};
 }
 
-static civil_writable_rcrd add_milliseconds_or_microseconds_or_nanoseconds(const civil_rcrd& x,
-                                                                           const cpp11::integers& n,
-                                                                           const enum unit& unit_val,
-                                                                           const r_ssize& size) {
-  civil_writable_rcrd out = civil_rcrd_clone(x);
-  civil_rcrd_recycle(out, size);
+// -----------------------------------------------------------------------------
+
+/*
+ * The clock unit loops are templated on the unit and on whether `n` is
+ * recycled, and the switch over the two happens once per call rather than once
+ * per element. What is left in the loop body is integer arithmetic on the
+ * fields, with missing values computed like any other and masked out on the
+ * way back, so the loops have no branches for the compiler to trip over.
+ */
+
+template <class Unit, bool recycle_n>
+static void add_hours_or_minutes_or_seconds_loop(int* p_days,
+                                                 int* p_time_of_day,
+                                                 const int* p_n,
+                                                 const r_ssize& size) {
+  for (r_ssize i = 0; i < size; ++i) {
+    const int elt_days = p_days[i];
+    const int elt_time_of_day = p_time_of_day[i];
+    const int elt_n = p_n[recycle_n ? 0 : i];
+
+    const bool na = elt_days == r_int_na || elt_n == r_int_na;
+
+    // Missing days are swapped for a placeholder so the masked out arithmetic
+    // on them can't overflow
+    const fields_datetime fdt = plus_time_of_day(
+      date::days{na ? 0 : elt_days},
+      std::chrono::seconds{elt_time_of_day},
+      Unit{elt_n}
+    );
+
+    p_days[i] = na ? r_int_na : fdt.days.count();
+    p_time_of_day[i] = na ? r_int_na : static_cast<int>(fdt.time_of_day.count());
+  }
+}
+
+template <class Unit>
+static inline void add_hours_or_minutes_or_seconds_recycle(int* p_days,
+                                                           int* p_time_of_day,
+                                                           const int* p_n,
+                                                           const bool& recycle_n,
+                                                           const r_ssize& size) {
+  if (recycle_n) {
+    add_hours_or_minutes_or_seconds_loop<Unit, true>(p_days, p_time_of_day, p_n, size);
+  } else {
+    add_hours_or_minutes_or_seconds_loop<Unit, false>(p_days, p_time_of_day, p_n, size);
+  }
+}
+
+static civil_writable_rcrd add_hours_or_minutes_or_seconds(SEXP x,
+                                                           const cpp11::integers& n,
+                                                           const enum unit& unit_val,
+                                                           const r_ssize& size) {
+  civil_writable_rcrd out = civil_rcrd_clone(x, size);
 
   int* p_days = civil_rcrd_days_deref(out);
   int* p_time_of_day = civil_rcrd_time_of_day_deref(out);
   int* p_nanos_of_second = civil_rcrd_nanos_of_second_deref(out);
 
   const bool recycle_n = civil_is_scalar(n);
+  const int* p_n = civil_int_deref_const(n);
 
-  for (r_ssize i = 0; i < size; ++i) {
-    int elt_days = p_days[i];
-    int elt_time_of_day = p_time_of_day[i];
-    int elt_nanos_of_second = p_nanos_of_second[i];
-    int elt_n = recycle_n ? n[0] : n[i];
+  switch (unit_val) {
+  case unit::hour: {
+    add_hours_or_minutes_or_seconds_recycle<std::chrono::hours>(p_days, p_time_of_day, p_n, recycle_n, size);
+    break;
+  }
+  case unit::minute: {
+    add_hours_or_minutes_or_seconds_recycle<std::chrono::minutes>(p_days, p_time_of_day, p_n, recycle_n, size);
+    break;
+  }
+  case unit::second: {
+    add_hours_or_minutes_or_seconds_recycle<std::chrono::seconds>(p_days, p_time_of_day, p_n, recycle_n, size);
+    break;
+  }
+  default: {
+    civil_abort("Internal error: Unknown `unit_val` in `add_hours_or_minutes_or_seconds()`.");
+  }
+  }
 
-    if (elt_days == r_int_na) {
-      continue;
-    }
-    if (elt_n == r_int_na) {
-      civil_rcrd_assign_missing(i, p_days, p_time_of_day, p_nanos_of_second);
-      continue;
+  // Nano datetimes carry a third field that the loop leaves alone. An element
+  // comes out of the loop missing exactly when it has to be missing here too.
+  if (p_nanos_of_second != NULL) {
+    for (r_ssize i = 0; i < size; ++i) {
+      p_nanos_of_second[i] = p_days[i] == r_int_na ? r_int_na : p_nanos_of_second[i];
     }
+  }
 
-    std::chrono::nanoseconds elt_chrono_n;
+  return out;
+}
 
-    if (unit_val == unit::millisecond) {
-      elt_chrono_n = std::chrono::milliseconds{elt_n};
-    } else if (unit_val == unit::microsecond) {
-      elt_chrono_n = std::chrono::microseconds{elt_n};
-    } else if (unit_val == unit::nanosecond) {
-      elt_chrono_n = std::chrono::nanoseconds{elt_n};
-    }
+[[cpp11::register]]
+civil_writable_rcrd add_hours_or_minutes_or_seconds_cpp(SEXP x,
+                                                        const cpp11::integers& n,
+                                                        const cpp11::strings& unit,
+                                                        const cpp11::integers& size) {
+  enum unit unit_val = parse_unit(unit);
+  r_ssize c_size = size[0];
+
+  return add_hours_or_minutes_or_seconds(x, n, unit_val, c_size);
+}
+
+// -----------------------------------------------------------------------------
 
-    fields_nano_datetime fndt = plus_nanos_of_second(
-      date::days{elt_days},
+template <class Unit, bool recycle_n>
+static void add_milliseconds_or_microseconds_or_nanoseconds_loop(int* p_days,
+                                                                 int* p_time_of_day,
+                                                                 int* p_nanos_of_second,
+                                                                 const int* p_n,
+                                                                 const r_ssize& size) {
+  for (r_ssize i = 0; i < size; ++i) {
+    const int elt_days = p_days[i];
+    const int elt_time_of_day = p_time_of_day[i];
+    const int elt_nanos_of_second = p_nanos_of_second[i];
+    const int elt_n = p_n[recycle_n ? 0 : i];
+
+    const bool na = elt_days == r_int_na || elt_n == r_int_na;
+
+    const fields_nano_datetime fndt = plus_nanos_of_second(
+      date::days{na ? 0 : elt_days},
       std::chrono::seconds{elt_time_of_day},
       std::chrono::nanoseconds{elt_nanos_of_second},
-      elt_chrono_n
+      Unit{elt_n}
     );
 
-    p_days[i] = fndt.days.count();
-    p_time_of_day[i] = fndt.time_of_day.count();
-    p_nanos_of_second[i] = fndt.nanos_of_second.count();
+    p_days[i] = na ? r_int_na : fndt.days.count();
+    p_time_of_day[i] = na ? r_int_na : static_cast<int>(fndt.time_of_day.count());
+    p_nanos_of_second[i] = na ? r_int_na : static_cast<int>(fndt.nanos_of_second.count());
+  }
+}
+
+template <class Unit>
+static inline void add_milliseconds_or_microseconds_or_nanoseconds_recycle(int* p_days,
+                                                                           int* p_time_of_day,
+                                                                           int* p_nanos_of_second,
+                                                                           const int* p_n,
+                                                                           const bool& recycle_n,
+                                                                           const r_ssize& size) {
+  if (recycle_n) {
+    add_milliseconds_or_microseconds_or_nanoseconds_loop<Unit, true>(p_days, p_time_of_day, p_nanos_of_second, p_n, size);
+  } else {
+    add_milliseconds_or_microseconds_or_nanoseconds_loop<Unit, false>(p_days, p_time_of_day, p_nanos_of_second, p_n, size);
+  }
+}
+
+static civil_writable_rcrd add_milliseconds_or_microseconds_or_nanoseconds(SEXP x,
+                                                                           const cpp11::integers& n,
+                                                                           const enum unit& unit_val,
+                                                                           const r_ssize& size) {
+  civil_writable_rcrd out = civil_rcrd_clone(x, size);
+
+  int* p_days = civil_rcrd_days_deref(out);
+  int* p_time_of_day = civil_rcrd_time_of_day_deref(out);
+  int* p_nanos_of_second = civil_rcrd_nanos_of_second_deref(out);
+
+  const bool recycle_n = civil_is_scalar(n);
+  const int* p_n = civil_int_deref_const(n);
+
+  switch (unit_val) {
+  case unit::millisecond: {
+    add_milliseconds_or_microseconds_or_nanoseconds_recycle<std::chrono::milliseconds>(p_days, p_time_of_day, p_nanos_of_second, p_n, recycle_n, size);
+    break;
+  }
+  case unit::microsecond: {
+    add_milliseconds_or_microseconds_or_nanoseconds_recycle<std::chrono::microseconds>(p_days, p_time_of_day, p_nanos_of_second, p_n, recycle_n, size);
+    break;
+  }
+  case unit::nanosecond: {
+    add_milliseconds_or_microseconds_or_nanoseconds_recycle<std::chrono::nanoseconds>(p_days, p_time_of_day, p_nanos_of_second, p_n, recycle_n, size);
+    break;
+  }
+  default: {
+    civil_abort("Internal error: Unknown `unit_val` in `add_milliseconds_or_microseconds_or_nanoseconds()`.");
+  }
   }
 
   return out;
 }
 
 [[cpp11::register]]
-civil_writable_rcrd add_milliseconds_or_microseconds_or_nanoseconds_cpp(const civil_rcrd& x,
+civil_writable_rcrd add_milliseconds_or_microseconds_or_nanoseconds_cpp(SEXP x,
                                                                         const cpp11::integers& n,
                                                                         const cpp11::strings& unit,
                                                                         const cpp11::integers& size) {
@@ -310,3 +366,109 @@ civil_writable_rcrd add_milliseconds_or_microseconds_or_nanoseconds_cpp(const ci
   return add_milliseconds_or_microseconds_or_nanoseconds(x, n, unit_val, c_size);
 }
 
+// -----------------------------------------------------------------------------
+
+/*
+ * Calendar arithmetic on zoned datetimes and nano datetimes, fused into one
+ * pass. Each element goes from sys time to local time, has the period added
+ * to it in local time, and then goes back to sys time with the DST policies.
+ * This is what `as_local()`, the local `add_*()` and `as_zoned()` do in turn,
+ * but without the two intermediate records.
+ */
+static civil_writable_rcrd add_calendar_zoned(SEXP x,
+                                              const cpp11::integers& n,
+                                              const cpp11::strings& zone,
+                                              const enum day_nonexistent& day_nonexistent_val,
+                                              const cpp11::integers& dst_nonexistent,
+                                              const cpp11::integers& dst_ambiguous,
+                                              const enum unit& unit_val,
+                                              const r_ssize& size) {
+  civil_writable_rcrd out = civil_rcrd_clone(x, size);
+
+  zoned_fields fields(out, dst_nonexistent, dst_ambiguous);
+
+  const bool recycle_n = civil_is_scalar(n);
+  const int* p_n = civil_int_deref_const(n);
+
+  zone_lookups lookups(zone, size);
+
+  for (r_ssize i = 0; i < size; ++i) {
+    int elt_n = p_n[recycle_n ? 0 : i];
+
+    if (fields.is_missing(i)) {
+      continue;
+    }
+    if (elt_n == r_int_na) {
+      fields.assign_missing(i);
+      continue;
+    }
+
+    zone_lookup& lookup = lookups[i];
+
+    // Zoned -> local
+    const date::local_seconds elt_lsec = fields.to_local(i, lookup);
+
+    date::local_days elt_lday = date::floor<date::days>(elt_lsec);
+    std::chrono::seconds elt_tod{elt_lsec - elt_lday};
+    std::chrono::nanoseconds elt_nanos = fields.nanos_of_second(i);
+
+    // Add the period in local time
+    if (unit_val == unit::year || unit_val == unit::month) {
+      date::year_month_day elt_ymd = days_to_ymd_one(elt_lday.time_since_epoch().count());
+
+      if (unit_val == unit::year) {
+        elt_ymd += date::years{elt_n};
+      } else {
+        elt_ymd += date::months{elt_n};
+      }
+
+      if (!elt_ymd.ok()) {
+        bool na = false;
+        resolve_day_nonexistent_ymd(i, day_nonexistent_val, elt_ymd, na);
+
+        if (na) {
+          fields.assign_missing(i);
+          continue;
+        }
+
+        resolve_day_nonexistent_tod(day_nonexistent_val, elt_tod);
+        resolve_day_nonexistent_nanos_of_second(day_nonexistent_val, elt_nanos);
+      }
+
+      elt_lday = date::local_days{date::days{ymd_to_days_one(elt_ymd)}};
+    } else {
+      // Handle weeks as a period of 7 days
+      elt_lday += date::days{unit_val == unit::week ? elt_n * 7 : elt_n};
+    }
+
+    // Local -> zoned
+    fields.assign(i, elt_lday + elt_tod, elt_nanos, lookup);
+  }
+
+  return out;
+}
+
+[[cpp11::register]]
+civil_writable_rcrd add_calendar_zoned_cpp(SEXP x,
+                                           const cpp11::integers& n,
+                                           const cpp11::strings& zone,
+                                           const cpp11::strings& day_nonexistent,
+                                           const cpp11::integers& dst_nonexistent,
+                                           const cpp11::integers& dst_ambiguous,
+                                           const cpp11::strings& unit,
+                                           const cpp11::integers& size) {
+  enum day_nonexistent day_nonexistent_val = parse_day_nonexistent(day_nonexistent);
+  enum unit unit_val = parse_unit(unit);
+  r_ssize c_size = size[0];
+
+  return add_calendar_zoned(
+    x,
+    n,
+    zone,
+    day_nonexistent_val,
+    dst_nonexistent,
+    dst_ambiguous,
+    unit_val,
+    c_size
+  );
+}
@@ -0,0 +1,21 @@
+#include "civil-rcrd.h"
+
+// -----------------------------------------------------------------------------
+
+// [[ include("civil-rcrd.h") ]]
+uint64_t civil_rcrd_reused_fields = 0;
+
+/*
+ * Fields that `civil_rcrd_clone()` reused rather than copied in this session,
+ * optionally resetting the count afterwards
+ */
+[[cpp11::register]]
+double civil_rcrd_reused_fields_cpp(const bool& reset) {
+  const double out = static_cast<double>(civil_rcrd_reused_fields);
+
+  if (reset) {
+    civil_rcrd_reused_fields = 0;
+  }
+
+  return out;
+}
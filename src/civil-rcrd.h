@@ -3,6 +3,7 @@
 
 #include "civil.h"
 #include "utils.h"
+#include <vector>
 
 // -----------------------------------------------------------------------------
 
@@ -21,19 +22,18 @@ static inline void civil_writable_rcrd_set(civil_writable_rcrd& x,
 
 static inline void civil_rcrd_recycle(civil_writable_rcrd& x,
                                       const r_ssize& size) {
-  r_ssize x_size = x[0].size();
+  r_ssize x_size = civil_length(VECTOR_ELT(x, 0));
 
-  // Avoiding a copy from `civil_int_recycle()` that happens even when the
-  // sizes are the same.
-  // TODO: Is there a better way to structure `civil_int_recycle()`?
   if (x_size == size) {
     return;
   }
 
   r_ssize n = x.size();
 
+  // Scalar fields become compact repeats, which are only expanded when a
+  // kernel writes to them, see `civil_rcrd_field`
   for (r_ssize i = 0; i < n; ++i) {
-    civil_writable_rcrd_set(x, i, civil_int_recycle(x[i], size));
+    SET_VECTOR_ELT(x, i, civil_int_recycle(VECTOR_ELT(x, i), size));
   }
 
   // Ensure names get recycled
@@ -63,6 +63,74 @@ static inline const int* civil_rcrd_nanos_of_second_deref_const(civil_rcrd& x) {
   return x.size() < 3 ? NULL : civil_int_deref_const(x[2].data());
 }
 
+/*
+ * A field of a kernel's output record, for kernels that write to some fields
+ * only for some elements. Adding days only writes `time_of_day` for missing
+ * values, for example.
+ *
+ * A field recycled from a scalar is a compact repeat, and is read with a
+ * stride of 0 until the first write expands it. A field that the record
+ * doesn't have, like `time_of_day` for a date, reads as `0` and ignores
+ * writes, like the `NULL` pointers from `civil_rcrd_time_of_day_deref()`.
+ */
+class civil_rcrd_field {
+public:
+  civil_rcrd_field(civil_writable_rcrd& x, const r_ssize& j)
+    : x_(j < x.size() ? VECTOR_ELT(x, j) : r_null),
+      p_read_(NULL),
+      p_write_(NULL),
+      stride_(1) {
+    if (x_ == r_null) {
+      return;
+    }
+
+    p_read_ = civil_compact_rep_int_value(x_);
+
+    if (p_read_ != NULL) {
+      stride_ = 0;
+    } else {
+      p_write_ = civil_int_deref(x_);
+      p_read_ = p_write_;
+    }
+  }
+
+  bool exists() const {
+    return x_ != r_null;
+  }
+
+  int operator[](const r_ssize& i) const {
+    return p_read_ == NULL ? 0 : p_read_[i * stride_];
+  }
+
+  void set(const r_ssize& i, const int& value) {
+    if (x_ == r_null) {
+      return;
+    }
+    if (p_write_ == NULL) {
+      // Expands the compact repeat in place
+      p_write_ = civil_int_deref(x_);
+      p_read_ = p_write_;
+      stride_ = 1;
+    }
+    p_write_[i] = value;
+  }
+
+private:
+  SEXP x_;
+  const int* p_read_;
+  int* p_write_;
+  r_ssize stride_;
+};
+
+static inline void civil_rcrd_assign_missing(const r_ssize& i,
+                                             civil_rcrd_field& days,
+                                             civil_rcrd_field& time_of_day,
+                                             civil_rcrd_field& nanos_of_second) {
+  days.set(i, r_int_na);
+  time_of_day.set(i, r_int_na);
+  nanos_of_second.set(i, r_int_na);
+}
+
 static inline void civil_rcrd_assign_missing(const r_ssize& i,
                                              int* p_days,
                                              int* p_time_of_day,
@@ -79,18 +147,55 @@ static inline void civil_rcrd_assign_missing(const r_ssize& i,
 }
 
 /*
+ * Creates the record that a kernel writes its result into, recycled to `size`.
+ *
  * - Shallow duplicate the list (cpp11 does this for us), including all
- *   attributes
- * - Shallow duplicate each element, which shallow duplicating the list doesn't
- *   do.
+ *   attributes.
+ * - If `x` has to be recycled, the recycled fields are fresh allocations and
+ *   are written to directly.
+ * - Otherwise, shallow duplicate each field that anything other than `x`
+ *   might refer to, which shallow duplicating the list doesn't do. A field is
+ *   only reused as is when neither `x` nor the field is shared, i.e. when `x`
+ *   is a temporary that was passed straight to the `_cpp()` function. Then the
+ *   result is the only thing that will ever see that field.
+ *
+ * `x` must be the `SEXP` that came in through `.Call()`. Once cpp11 wraps an
+ * object, its preserve list holds a reference to it, and it always looks
+ * shared. For the same reason, R callers pass a promoted input inline, as in
+ * `f_cpp(promote(x))`. Binding it to a variable first would make the promoted
+ * temporary look shared too, and its fields would be copied.
+ *
+ * Fields reused as is are counted in `civil_rcrd_reused_fields`, see
+ * `civil_rcrd_reused_fields_cpp()`.
  */
-static inline civil_writable_rcrd civil_rcrd_clone(const civil_rcrd& x) {
+extern uint64_t civil_rcrd_reused_fields;
+
+static inline civil_writable_rcrd civil_rcrd_clone(SEXP x, const r_ssize& size) {
+  const r_ssize n = Rf_xlength(x);
+  const bool shared = MAYBE_SHARED(x);
+
+  std::vector<bool> shared_fields(n);
+
+  for (r_ssize i = 0; i < n; ++i) {
+    shared_fields[i] = shared || MAYBE_SHARED(VECTOR_ELT(x, i));
+  }
+
+  const bool recycle = Rf_xlength(VECTOR_ELT(x, 0)) != size;
+
   // Shallow duplicate with attributes
-  civil_writable_rcrd out(x);
+  const civil_rcrd rcrd(x);
+  civil_writable_rcrd out(rcrd);
 
-  r_ssize n = out.size();
+  if (recycle) {
+    civil_rcrd_recycle(out, size);
+    return out;
+  }
 
   for (r_ssize i = 0; i < n; ++i) {
+    if (!shared_fields[i]) {
+      ++civil_rcrd_reused_fields;
+      continue;
+    }
     // FIXME: out[i] = cpp11::safe[Rf_shallow_duplicate](out[i]);
     civil_writable_rcrd_set(out, i, cpp11::safe[Rf_shallow_duplicate](out[i]));
   }
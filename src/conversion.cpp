@@ -44,8 +44,9 @@ static inline date::sys_seconds info_nonexistent_na(bool& na) {
   return date::sys_seconds::max();
 }
 
-static inline date::sys_seconds info_nonexistent_error(const r_ssize& i) {
-  civil_abort("Nonexistent time due to daylight savings at location %i.", (int) i + 1);
+static inline date::sys_seconds info_nonexistent_error(enum conversion_error& error) {
+  error = conversion_error::nonexistent;
+  return date::sys_seconds::max();
 }
 
 // -----------------------------------------------------------------------------
@@ -76,23 +77,51 @@ static inline date::sys_seconds info_ambiguous_na(bool& na) {
   return date::sys_seconds::max();
 }
 
-static inline date::sys_seconds info_ambiguous_error(const r_ssize& i) {
-  civil_abort("Ambiguous time due to daylight savings at location %i.", (int) i + 1);
+static inline date::sys_seconds info_ambiguous_error(enum conversion_error& error) {
+  error = conversion_error::ambiguous;
+  return date::sys_seconds::max();
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Raises the error for a failed conversion at location `i`. Must be called
+ * on the main thread.
+ */
+// [[ include("conversion.h") ]]
+void stop_conversion_error(const enum conversion_error& error, const r_ssize& i) {
+  switch (error) {
+  case conversion_error::nonexistent: {
+    civil_abort("Nonexistent time due to daylight savings at location %i.", (int) i + 1);
+  }
+  case conversion_error::ambiguous: {
+    civil_abort("Ambiguous time due to daylight savings at location %i.", (int) i + 1);
+  }
+  case conversion_error::none: {
+    break;
+  }
+  }
+
+  never_reached("stop_conversion_error");
 }
 
 // -----------------------------------------------------------------------------
 
 /*
  * Converts local_seconds to sys_seconds
+ *
+ * Doesn't call back into R, so it is safe to use off the main thread. When
+ * the DST arguments say to error, `error` is set instead, and the caller
+ * raises it with `stop_conversion_error()`.
  */
 // [[ include("conversion.h") ]]
 date::sys_seconds convert_local_to_sys(const date::local_seconds& lsec,
-                                       const date::time_zone* p_zone,
-                                       const r_ssize& i,
+                                       zone_lookup& lookup,
                                        const enum dst_nonexistent& dst_nonexistent_val,
                                        const enum dst_ambiguous& dst_ambiguous_val,
-                                       bool& na) {
-  date::local_info info = p_zone->get_info(lsec);
+                                       bool& na,
+                                       enum conversion_error& error) {
+  const date::local_info& info = lookup.get_info(lsec);
 
   if (info.result == date::local_info::unique) {
     return info_unique(info, lsec);
@@ -116,7 +145,7 @@ date::sys_seconds convert_local_to_sys(const date::local_seconds& lsec,
       return info_nonexistent_na(na);
     }
     case dst_nonexistent::error: {
-      return info_nonexistent_error(i);
+      return info_nonexistent_error(error);
     }
     }
   }
@@ -133,7 +162,7 @@ date::sys_seconds convert_local_to_sys(const date::local_seconds& lsec,
       return info_ambiguous_na(na);
     }
     case dst_ambiguous::error: {
-      return info_ambiguous_error(i);
+      return info_ambiguous_error(error);
     }
     }
   }
@@ -150,16 +179,18 @@ date::sys_seconds convert_local_to_sys(const date::local_seconds& lsec,
  *
  * `get_info()` floors to seconds, but that is appropriate because DST
  * handling is really only precise to the second level.
+ *
+ * Like the seconds version, errors are reported through `error`.
  */
 // [[ include("conversion.h") ]]
 date::sys_seconds convert_local_to_sys(const date::local_seconds& lsec,
-                                       const date::time_zone* p_zone,
-                                       const r_ssize& i,
+                                       zone_lookup& lookup,
                                        const enum dst_nonexistent& dst_nonexistent_val,
                                        const enum dst_ambiguous& dst_ambiguous_val,
                                        bool& na,
+                                       enum conversion_error& error,
                                        std::chrono::nanoseconds& nanos) {
-  date::local_info info = p_zone->get_info(lsec);
+  const date::local_info& info = lookup.get_info(lsec);
 
   if (info.result == date::local_info::unique) {
     return info_unique(info, lsec);
@@ -185,7 +216,7 @@ date::sys_seconds convert_local_to_sys(const date::local_seconds& lsec,
       return info_nonexistent_na(na);
     }
     case dst_nonexistent::error: {
-      return info_nonexistent_error(i);
+      return info_nonexistent_error(error);
     }
     }
   }
@@ -202,10 +233,68 @@ date::sys_seconds convert_local_to_sys(const date::local_seconds& lsec,
       return info_ambiguous_na(na);
     }
     case dst_ambiguous::error: {
-      return info_ambiguous_error(i);
+      return info_ambiguous_error(error);
     }
     }
   }
 
   never_reached("convert_local_to_sys");
 }
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Main thread versions that error straight away
+ */
+
+// [[ include("conversion.h") ]]
+date::sys_seconds convert_local_to_sys(const date::local_seconds& lsec,
+                                       zone_lookup& lookup,
+                                       const r_ssize& i,
+                                       const enum dst_nonexistent& dst_nonexistent_val,
+                                       const enum dst_ambiguous& dst_ambiguous_val,
+                                       bool& na) {
+  enum conversion_error error = conversion_error::none;
+
+  date::sys_seconds out = convert_local_to_sys(
+    lsec,
+    lookup,
+    dst_nonexistent_val,
+    dst_ambiguous_val,
+    na,
+    error
+  );
+
+  if (error != conversion_error::none) {
+    stop_conversion_error(error, i);
+  }
+
+  return out;
+}
+
+// [[ include("conversion.h") ]]
+date::sys_seconds convert_local_to_sys(const date::local_seconds& lsec,
+                                       zone_lookup& lookup,
+                                       const r_ssize& i,
+                                       const enum dst_nonexistent& dst_nonexistent_val,
+                                       const enum dst_ambiguous& dst_ambiguous_val,
+                                       bool& na,
+                                       std::chrono::nanoseconds& nanos) {
+  enum conversion_error error = conversion_error::none;
+
+  date::sys_seconds out = convert_local_to_sys(
+    lsec,
+    lookup,
+    dst_nonexistent_val,
+    dst_ambiguous_val,
+    na,
+    error,
+    nanos
+  );
+
+  if (error != conversion_error::none) {
+    stop_conversion_error(error, i);
+  }
+
+  return out;
+}
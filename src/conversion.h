@@ -3,20 +3,199 @@
 
 #include "civil.h"
 #include "enums.h"
+#include "zone.h"
+#include "civil-rcrd.h"
+
+/*
+ * Why a conversion failed, for kernels that can't call back into R at the
+ * point of failure
+ */
+enum class conversion_error {
+  none,
+  nonexistent,
+  ambiguous
+};
+
+void stop_conversion_error(const enum conversion_error& error, const r_ssize& i);
+
+date::sys_seconds convert_local_to_sys(const date::local_seconds& lsec,
+                                       zone_lookup& lookup,
+                                       const enum dst_nonexistent& dst_nonexistent_val,
+                                       const enum dst_ambiguous& dst_ambiguous_val,
+                                       bool& na,
+                                       enum conversion_error& error);
+
+date::sys_seconds convert_local_to_sys(const date::local_seconds& lsec,
+                                       zone_lookup& lookup,
+                                       const enum dst_nonexistent& dst_nonexistent_val,
+                                       const enum dst_ambiguous& dst_ambiguous_val,
+                                       bool& na,
+                                       enum conversion_error& error,
+                                       std::chrono::nanoseconds& nanos);
 
 date::sys_seconds convert_local_to_sys(const date::local_seconds& lsec,
-                                       const date::time_zone* p_zone,
+                                       zone_lookup& lookup,
                                        const r_ssize& i,
                                        const enum dst_nonexistent& dst_nonexistent_val,
                                        const enum dst_ambiguous& dst_ambiguous_val,
                                        bool& na);
 
 date::sys_seconds convert_local_to_sys(const date::local_seconds& lsec,
-                                       const date::time_zone* p_zone,
+                                       zone_lookup& lookup,
                                        const r_ssize& i,
                                        const enum dst_nonexistent& dst_nonexistent_val,
                                        const enum dst_ambiguous& dst_ambiguous_val,
                                        bool& na,
                                        std::chrono::nanoseconds& nanos);
 
+// -----------------------------------------------------------------------------
+
+/*
+ * The zoned side of the fused zoned kernels, like `add_calendar_zoned()` and
+ * `round_zoned()`. They take each element of a zoned record to local time
+ * with `to_local()`, change it there, and write it back to the same element
+ * as zoned time with `assign()`, which applies the DST arguments. `x` is the
+ * record from `civil_rcrd_clone()`, so this happens in place.
+ */
+class zoned_fields {
+public:
+  zoned_fields(civil_writable_rcrd& x,
+               const cpp11::integers& dst_nonexistent,
+               const cpp11::integers& dst_ambiguous);
+
+  bool is_missing(const r_ssize& i) const;
+  std::chrono::nanoseconds nanos_of_second(const r_ssize& i) const;
+
+  date::local_seconds to_local(const r_ssize& i, zone_lookup& lookup) const;
+  date::local_seconds to_local(const r_ssize& i,
+                               zone_lookup& lookup,
+                               std::chrono::seconds& offset) const;
+
+  void assign(const r_ssize& i,
+              const date::local_seconds& lsec,
+              std::chrono::nanoseconds nanos,
+              zone_lookup& lookup);
+  void assign(const r_ssize& i,
+              const date::local_seconds& lsec,
+              std::chrono::nanoseconds nanos,
+              zone_lookup& lookup,
+              const std::chrono::seconds& offset);
+  void assign_missing(const r_ssize& i);
+
+private:
+  int* p_days_;
+  int* p_time_of_day_;
+  int* p_nanos_of_second_;
+
+  const int* p_dst_nonexistent_;
+  const int* p_dst_ambiguous_;
+  bool recycle_dst_nonexistent_;
+  bool recycle_dst_ambiguous_;
+
+  void assign_sys(const r_ssize& i,
+                  const date::sys_seconds& ssec,
+                  const std::chrono::nanoseconds& nanos);
+};
+
+inline zoned_fields::zoned_fields(civil_writable_rcrd& x,
+                                  const cpp11::integers& dst_nonexistent,
+                                  const cpp11::integers& dst_ambiguous)
+  : p_days_(civil_rcrd_days_deref(x)),
+    p_time_of_day_(civil_rcrd_time_of_day_deref(x)),
+    p_nanos_of_second_(civil_rcrd_nanos_of_second_deref(x)),
+    p_dst_nonexistent_(civil_int_deref_const(dst_nonexistent)),
+    p_dst_ambiguous_(civil_int_deref_const(dst_ambiguous)),
+    recycle_dst_nonexistent_(civil_is_scalar(dst_nonexistent)),
+    recycle_dst_ambiguous_(civil_is_scalar(dst_ambiguous)) {}
+
+inline bool zoned_fields::is_missing(const r_ssize& i) const {
+  return p_days_[i] == r_int_na;
+}
+
+inline std::chrono::nanoseconds zoned_fields::nanos_of_second(const r_ssize& i) const {
+  return std::chrono::nanoseconds{p_nanos_of_second_ == NULL ? 0 : p_nanos_of_second_[i]};
+}
+
+/*
+ * Also gives the offset that `x` has at element `i`
+ */
+inline date::local_seconds zoned_fields::to_local(const r_ssize& i,
+                                                  zone_lookup& lookup,
+                                                  std::chrono::seconds& offset) const {
+  const date::sys_seconds ssec = date::sys_days{date::days{p_days_[i]}} + std::chrono::seconds{p_time_of_day_[i]};
+  offset = lookup.get_info(ssec).offset;
+  return date::local_seconds{(ssec + offset).time_since_epoch()};
+}
+
+inline date::local_seconds zoned_fields::to_local(const r_ssize& i, zone_lookup& lookup) const {
+  std::chrono::seconds offset;
+  return to_local(i, lookup, offset);
+}
+
+inline void zoned_fields::assign(const r_ssize& i,
+                                 const date::local_seconds& lsec,
+                                 std::chrono::nanoseconds nanos,
+                                 zone_lookup& lookup) {
+  const enum dst_nonexistent dst_nonexistent_val =
+    dst_nonexistent_from_code(p_dst_nonexistent_[recycle_dst_nonexistent_ ? 0 : i]);
+
+  const enum dst_ambiguous dst_ambiguous_val =
+    dst_ambiguous_from_code(p_dst_ambiguous_[recycle_dst_ambiguous_ ? 0 : i]);
+
+  bool na = false;
+  date::sys_seconds ssec;
+
+  if (p_nanos_of_second_ == NULL) {
+    ssec = convert_local_to_sys(lsec, lookup, i, dst_nonexistent_val, dst_ambiguous_val, na);
+  } else {
+    ssec = convert_local_to_sys(lsec, lookup, i, dst_nonexistent_val, dst_ambiguous_val, na, nanos);
+  }
+
+  if (na) {
+    assign_missing(i);
+    return;
+  }
+
+  assign_sys(i, ssec, nanos);
+}
+
+/*
+ * Like `assign()`, but an ambiguous `lsec` takes `offset` whenever that is one
+ * of its two offsets, and only falls back to `dst_ambiguous` otherwise. With
+ * the offset from `to_local()`, the element stays on its side of an overlap.
+ */
+inline void zoned_fields::assign(const r_ssize& i,
+                                 const date::local_seconds& lsec,
+                                 std::chrono::nanoseconds nanos,
+                                 zone_lookup& lookup,
+                                 const std::chrono::seconds& offset) {
+  const date::local_info& info = lookup.get_info(lsec);
+
+  if (info.result == date::local_info::ambiguous &&
+      (info.first.offset == offset || info.second.offset == offset)) {
+    assign_sys(i, date::sys_seconds{lsec.time_since_epoch()} - offset, nanos);
+    return;
+  }
+
+  assign(i, lsec, nanos, lookup);
+}
+
+inline void zoned_fields::assign_missing(const r_ssize& i) {
+  civil_rcrd_assign_missing(i, p_days_, p_time_of_day_, p_nanos_of_second_);
+}
+
+inline void zoned_fields::assign_sys(const r_ssize& i,
+                                     const date::sys_seconds& ssec,
+                                     const std::chrono::nanoseconds& nanos) {
+  const date::sys_days sday = date::floor<date::days>(ssec);
+  const std::chrono::seconds tod{ssec - sday};
+
+  p_days_[i] = sday.time_since_epoch().count();
+  p_time_of_day_[i] = tod.count();
+
+  if (p_nanos_of_second_ != NULL) {
+    p_nanos_of_second_[i] = nanos.count();
+  }
+}
+
 #endif
@@ -6,136 +6,389 @@
 #include "conversion.h"
 #include "resolve.h"
 #include "check.h"
+#include "parallel.h"
+#include "layout.h"
+#include "ymd.h"
+#include <algorithm>
+#include <limits>
 
 // -----------------------------------------------------------------------------
 
-[[cpp11::register]]
-civil_writable_rcrd convert_sys_seconds_to_local_days_and_time_of_day(const cpp11::doubles& seconds,
-                                                                      const cpp11::strings& zone) {
-  r_ssize size = seconds.size();
+/*
+ * The conversion kernels are templated over the storage layouts in `layout.h`,
+ * so the same kernel serves the fields and count layouts of local and zoned
+ * datetimes, as well as a POSIXct's own seconds. Each element is read as one
+ * 64-bit count of `Duration` and written back the same way.
+ */
 
-  civil_writable_field days(size);
-  civil_writable_field time_of_day(size);
+// -----------------------------------------------------------------------------
 
-  civil_writable_rcrd out = new_days_time_of_day_list(days, time_of_day);
+/*
+ * Pre-pass for the constant offset fast paths. It finds the range of the
+ * input, skipping missing values, and asks the zone whether that whole range
+ * falls in a single interval. If it does, the kernel converts every element
+ * with that one offset through `shift_datetime()`, in a loop free of tzdb
+ * lookups.
+ */
+template <class Clock, class Duration, class Reader>
+static bool datetime_constant_offset(const Reader& x,
+                                     const r_ssize& size,
+                                     zone_lookup& lookup,
+                                     std::chrono::seconds& offset,
+                                     bool& sorted) {
+  typedef std::chrono::time_point<Clock, Duration> time_point;
+
+  int64_t min = INT64_MAX;
+  int64_t max = INT64_MIN;
+  int64_t last = INT64_MIN;
 
-  cpp11::writable::strings zone_standard = zone_standardize(zone);
-  cpp11::r_string zone_name_r(zone_standard[0]);
-  std::string zone_name(zone_name_r);
-  const date::time_zone* p_time_zone = zone_name_load(zone_name);
+  sorted = true;
 
   for (r_ssize i = 0; i < size; ++i) {
-    double elt_seconds = seconds[i];
-    int64_t elt = as_int64(elt_seconds);
+    int64_t elt;
 
-    if (elt == r_int64_na) {
-      days[i] = r_int_na;
-      time_of_day[i] = r_int_na;
+    if (!x.get(i, elt)) {
       continue;
     }
 
-    std::chrono::seconds elt_sec{elt};
-    date::sys_seconds elt_ssec{elt_sec};
-    date::zoned_seconds elt_zsec = date::make_zoned(p_time_zone, elt_ssec);
-    date::local_seconds elt_lsec = elt_zsec.get_local_time();
+    sorted = sorted && last <= elt;
+    last = elt;
 
-    date::local_days elt_lday = date::floor<date::days>(elt_lsec);
-    date::local_seconds elt_lsec_floor{elt_lday};
+    min = std::min(min, elt);
+    max = std::max(max, elt);
+  }
 
-    std::chrono::seconds elt_tod_sec{elt_lsec - elt_lsec_floor};
+  if (min > max) {
+    return false;
+  }
+
+  return lookup.constant_offset(
+    date::floor<std::chrono::seconds>(time_point{Duration{min}}),
+    date::floor<std::chrono::seconds>(time_point{Duration{max}}),
+    offset
+  );
+}
 
-    days[i] = elt_lday.time_since_epoch().count();
-    time_of_day[i] = elt_tod_sec.count();
+template <class Reader, class Writer>
+static void shift_datetime(const Reader& x,
+                           Writer& out,
+                           const r_ssize& size,
+                           const int64_t& shift) {
+  for (r_ssize i = 0; i < size; ++i) {
+    int64_t elt;
+
+    if (!x.get(i, elt)) {
+      out.set_missing(i);
+      continue;
+    }
+
+    out.set(i, elt + shift);
   }
+}
 
-  return out;
+/*
+ * Unsorted input defeats the cached interval of a `zone_lookup`, so instead
+ * of looking elements up one at a time, their offsets are found in batches
+ * by `zone_lookup::get_offsets()`.
+ *
+ * Converts the elements in `[begin, end)`, so each thread can take a chunk.
+ */
+static const r_ssize sys_batch_size = 512;
+
+template <class Duration, class Reader, class Writer>
+static void sys_to_local_batched(const Reader& x,
+                                 Writer& out,
+                                 const r_ssize& begin,
+                                 const r_ssize& end,
+                                 zone_lookup& lookup) {
+  int64_t elts[sys_batch_size];
+  date::sys_seconds elt_ssecs[sys_batch_size];
+  std::chrono::seconds elt_offsets[sys_batch_size];
+  bool elt_missing[sys_batch_size];
+
+  for (r_ssize start = begin; start < end; start += sys_batch_size) {
+    const r_ssize n = std::min(sys_batch_size, end - start);
+
+    for (r_ssize j = 0; j < n; ++j) {
+      int64_t elt = 0;
+      // Missing values are looked up as the epoch, and dropped below
+      elt_missing[j] = !x.get(start + j, elt);
+      elts[j] = elt_missing[j] ? 0 : elt;
+      elt_ssecs[j] = date::floor<std::chrono::seconds>(date::sys_time<Duration>{Duration{elts[j]}});
+    }
+
+    lookup.get_offsets(elt_ssecs, n, elt_offsets);
+
+    for (r_ssize j = 0; j < n; ++j) {
+      const r_ssize i = start + j;
+
+      if (elt_missing[j]) {
+        out.set_missing(i);
+        continue;
+      }
+
+      out.set(i, elts[j] + std::chrono::duration_cast<Duration>(elt_offsets[j]).count());
+    }
+  }
 }
 
-[[cpp11::register]]
-cpp11::writable::doubles convert_local_days_and_time_of_day_to_sys_seconds_cpp(const civil_field& days,
-                                                                               const civil_field& time_of_day,
-                                                                               const cpp11::strings& zone,
-                                                                               const cpp11::strings& dst_nonexistent,
-                                                                               const cpp11::strings& dst_ambiguous,
-                                                                               const cpp11::integers& size) {
-  r_ssize c_size = size[0];
+/*
+ * Runs `sys_to_local_batched()` over `size` elements, split across the
+ * threads from the `civil.threads` option. Each thread gets its own
+ * `zone_lookup`, since they aren't safe to share.
+ */
+template <class Duration, class Reader, class Writer>
+static void sys_to_local_batched(const Reader& x,
+                                 Writer& out,
+                                 const r_ssize& size,
+                                 zone_lookup& lookup) {
+  const int n_threads = civil_threads(size);
+
+  if (n_threads == 1) {
+    sys_to_local_batched<Duration>(x, out, 0, size, lookup);
+    return;
+  }
+
+  const civil_zone* p_zone = lookup.zone();
 
-  cpp11::writable::doubles out(c_size);
+  parallel_for(size, n_threads, [&](r_ssize begin, r_ssize end) -> r_ssize {
+    zone_lookup chunk_lookup(p_zone);
+    sys_to_local_batched<Duration>(x, out, begin, end, chunk_lookup);
+    return -1;
+  });
+}
 
-  cpp11::writable::strings zone_standard = zone_standardize(zone);
-  cpp11::r_string zone_name_r(zone_standard[0]);
-  std::string zone_name(zone_name_r);
-  const date::time_zone* p_time_zone = zone_name_load(zone_name);
+/*
+ * Converts local elements to sys time, split across the threads from the
+ * `civil.threads` option. `elt(i, lookup)` converts element `i`, writing
+ * straight into the output buffers, and returns why it failed if the DST
+ * arguments say to error.
+ *
+ * Chunks stop at their first failure. The earliest one is converted again
+ * here on the main thread so its error can be raised through R.
+ */
+template <class Elt>
+static void local_to_sys_parallel(Elt elt,
+                                  const r_ssize& size,
+                                  const int& n_threads,
+                                  const civil_zone* p_zone) {
+  const r_ssize failure = parallel_for(size, n_threads, [&](r_ssize begin, r_ssize end) -> r_ssize {
+    zone_lookup lookup(p_zone);
+
+    for (r_ssize i = begin; i < end; ++i) {
+      if (elt(i, lookup) != conversion_error::none) {
+        return i;
+      }
+    }
 
-  bool recycle_days = civil_is_scalar(days);
-  bool recycle_time_of_day = civil_is_scalar(time_of_day);
-  bool recycle_dst_nonexistent = civil_is_scalar(dst_nonexistent);
-  bool recycle_dst_ambiguous = civil_is_scalar(dst_ambiguous);
+    return -1;
+  });
 
-  enum dst_nonexistent dst_nonexistent_val;
-  if (recycle_dst_nonexistent) {
-    dst_nonexistent_val = parse_dst_nonexistent_one(dst_nonexistent[0]);
+  if (failure != -1) {
+    zone_lookup lookup(p_zone);
+    stop_conversion_error(elt(failure, lookup), failure);
   }
+}
 
-  enum dst_ambiguous dst_ambiguous_val;
-  if (recycle_dst_ambiguous) {
-    dst_ambiguous_val = parse_dst_ambiguous_one(dst_ambiguous[0]);
+// -----------------------------------------------------------------------------
+
+/*
+ * Local to zoned conversion over any datetime layout, see `layout.h`. The
+ * count is split into seconds, which go through the time zone, and the
+ * subsecond remainder, which only changes when a nonexistent time is rolled.
+ */
+template <class Duration, class Reader, class Writer>
+static void convert_datetime_from_local_to_zoned(const Reader& x,
+                                                 Writer& out,
+                                                 const r_ssize& size,
+                                                 zone_lookups& lookups,
+                                                 const cpp11::integers& dst_nonexistent,
+                                                 const cpp11::integers& dst_ambiguous) {
+  const bool recycle_dst_nonexistent = civil_is_scalar(dst_nonexistent);
+  const bool recycle_dst_ambiguous = civil_is_scalar(dst_ambiguous);
+
+  const int* p_dst_nonexistent = civil_int_deref_const(dst_nonexistent);
+  const int* p_dst_ambiguous = civil_int_deref_const(dst_ambiguous);
+
+  const int64_t per_second = duration_per_second<Duration>();
+
+  std::chrono::seconds offset;
+  bool sorted = true;
+
+  if (lookups.is_scalar() &&
+      datetime_constant_offset<date::local_t, Duration>(x, size, lookups.scalar(), offset, sorted)) {
+    shift_datetime(x, out, size, -std::chrono::duration_cast<Duration>(offset).count());
+    return;
   }
 
-  for (r_ssize i = 0; i < c_size; ++i) {
-    const int elt_days = recycle_days ? days[0] : days[i];
-    const int elt_time_of_day = recycle_time_of_day ? time_of_day[0] : time_of_day[i];
+  auto elt = [&](r_ssize i, zone_lookup& lookup) -> enum conversion_error {
+    int64_t elt_x;
+
+    if (!x.get(i, elt_x)) {
+      out.set_missing(i);
+      return conversion_error::none;
+    }
+
+    date::local_time<Duration> elt_ltime{Duration{elt_x}};
+    date::local_seconds elt_lsec = date::floor<std::chrono::seconds>(elt_ltime);
+    std::chrono::nanoseconds elt_nanos{elt_ltime - elt_lsec};
 
     const enum dst_nonexistent elt_dst_nonexistent_val =
-      recycle_dst_nonexistent ?
-      dst_nonexistent_val :
-      parse_dst_nonexistent_one(dst_nonexistent[i]);
+      dst_nonexistent_from_code(p_dst_nonexistent[recycle_dst_nonexistent ? 0 : i]);
 
     const enum dst_ambiguous elt_dst_ambiguous_val =
-      recycle_dst_ambiguous ?
-      dst_ambiguous_val :
-      parse_dst_ambiguous_one(dst_ambiguous[i]);
+      dst_ambiguous_from_code(p_dst_ambiguous[recycle_dst_ambiguous ? 0 : i]);
 
-    if (elt_days == r_int_na || elt_time_of_day == r_int_na) {
-      out[i] = r_dbl_na;
-      continue;
+    bool na = false;
+    enum conversion_error error = conversion_error::none;
+    date::sys_seconds out_ssec;
+
+    if (per_second == 1) {
+      out_ssec = convert_local_to_sys(
+        elt_lsec,
+        lookup,
+        elt_dst_nonexistent_val,
+        elt_dst_ambiguous_val,
+        na,
+        error
+      );
+    } else {
+      out_ssec = convert_local_to_sys(
+        elt_lsec,
+        lookup,
+        elt_dst_nonexistent_val,
+        elt_dst_ambiguous_val,
+        na,
+        error,
+        elt_nanos
+      );
     }
 
-    date::local_days elt_lday{date::days{elt_days}};
-    date::local_seconds elt_lsec_floor{elt_lday};
+    if (na || error != conversion_error::none) {
+      out.set_missing(i);
+      return error;
+    }
 
-    std::chrono::seconds elt_tod{elt_time_of_day};
+    const Duration out_sub = std::chrono::duration_cast<Duration>(elt_nanos);
+    out.set(i, out_ssec.time_since_epoch().count() * per_second + out_sub.count());
 
-    date::local_seconds elt_lsec = elt_lsec_floor + elt_tod;
+    return conversion_error::none;
+  };
 
-    bool na = false;
+  const int n_threads = civil_threads(size);
 
-    date::sys_seconds out_ssec = convert_local_to_sys(
-      elt_lsec,
-      p_time_zone,
-      i,
-      elt_dst_nonexistent_val,
-      elt_dst_ambiguous_val,
-      na
-    );
-
-    if (na) {
-      out[i] = r_dbl_na;
-    } else {
-      out[i] = out_ssec.time_since_epoch().count();
+  if (n_threads > 1 && lookups.is_scalar()) {
+    local_to_sys_parallel(elt, size, n_threads, lookups.scalar().zone());
+    return;
+  }
+
+  for (r_ssize i = 0; i < size; ++i) {
+    const enum conversion_error error = elt(i, lookups[i]);
+
+    if (error != conversion_error::none) {
+      stop_conversion_error(error, i);
     }
   }
+}
 
-  return out;
+/*
+ * Zoned to local conversion over any datetime layout. The subsecond part is
+ * beneath time zone changes, so only the seconds are looked up.
+ */
+template <class Duration, class Reader, class Writer>
+static void convert_datetime_from_zoned_to_local(const Reader& x,
+                                                 Writer& out,
+                                                 const r_ssize& size,
+                                                 zone_lookups& lookups) {
+  std::chrono::seconds offset;
+  bool sorted = true;
+
+  if (lookups.is_scalar() &&
+      datetime_constant_offset<std::chrono::system_clock, Duration>(x, size, lookups.scalar(), offset, sorted)) {
+    shift_datetime(x, out, size, std::chrono::duration_cast<Duration>(offset).count());
+    return;
+  }
+
+  if (lookups.is_scalar() && !sorted) {
+    sys_to_local_batched<Duration>(x, out, size, lookups.scalar());
+    return;
+  }
+
+  for (r_ssize i = 0; i < size; ++i) {
+    zone_lookup& lookup = lookups[i];
+
+    int64_t elt_x;
+
+    if (!x.get(i, elt_x)) {
+      out.set_missing(i);
+      continue;
+    }
+
+    date::sys_time<Duration> elt_stime{Duration{elt_x}};
+    date::sys_seconds elt_ssec = date::floor<std::chrono::seconds>(elt_stime);
+
+    const date::sys_info& info = lookup.get_info(elt_ssec);
+
+    out.set(i, elt_x + std::chrono::duration_cast<Duration>(info.offset).count());
+  }
 }
 
 // -----------------------------------------------------------------------------
 
 [[cpp11::register]]
-civil_writable_rcrd convert_year_month_day_to_local_fields(const cpp11::integers& year,
-                                                           const cpp11::integers& month,
-                                                           const cpp11::integers& day,
-                                                           const cpp11::strings& day_nonexistent) {
+civil_writable_rcrd convert_sys_seconds_to_local_days_and_time_of_day_cpp(const cpp11::doubles& seconds,
+                                                                          const cpp11::strings& zone) {
+  r_ssize size = seconds.size();
+
+  posixct_reader x(seconds);
+  fields_writer<std::chrono::seconds> out(size);
+
+  zone_lookups lookups(zone, size);
+
+  convert_datetime_from_zoned_to_local<std::chrono::seconds>(x, out, size, lookups);
+
+  return out.result();
+}
+
+[[cpp11::register]]
+cpp11::writable::doubles convert_local_days_and_time_of_day_to_sys_seconds_cpp(const civil_field& days,
+                                                                               const civil_field& time_of_day,
+                                                                               const cpp11::strings& zone,
+                                                                               const cpp11::integers& dst_nonexistent,
+                                                                               const cpp11::integers& dst_ambiguous,
+                                                                               const cpp11::integers& size) {
+  r_ssize c_size = size[0];
+
+  fields_reader<std::chrono::seconds> x(days, time_of_day);
+  posixct_writer out(c_size);
+
+  zone_lookups lookups(zone, c_size);
+
+  convert_datetime_from_local_to_zoned<std::chrono::seconds>(
+    x,
+    out,
+    c_size,
+    lookups,
+    dst_nonexistent,
+    dst_ambiguous
+  );
+
+  return out.result();
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * These fill all days in one `ymd_to_days()` block pass, which gives `NA` for
+ * missing components. Their loops then check every element, and redo only the
+ * days of dates that don't exist and have to be resolved.
+ */
+
+[[cpp11::register]]
+civil_writable_rcrd convert_year_month_day_to_local_fields_cpp(const cpp11::integers& year,
+                                                               const cpp11::integers& month,
+                                                               const cpp11::integers& day,
+                                                               const cpp11::strings& day_nonexistent) {
   enum day_nonexistent day_nonexistent_val = parse_day_nonexistent(day_nonexistent);
 
   r_ssize size = year.size();
@@ -144,6 +397,14 @@ civil_writable_rcrd convert_year_month_day_to_local_fields(const cpp11::integers
 
   civil_writable_rcrd out = new_days_list(days);
 
+  ymd_to_days(
+    civil_int_deref_const(year),
+    civil_int_deref_const(month),
+    civil_int_deref_const(day),
+    size,
+    civil_int_deref(days)
+  );
+
   for (r_ssize i = 0; i < size; ++i) {
     int elt_year = year[i];
     int elt_month = month[i];
@@ -160,6 +421,10 @@ civil_writable_rcrd convert_year_month_day_to_local_fields(const cpp11::integers
     check_range_month(elt_month, "month");
     check_range_day(elt_day, "day");
 
+    if (ymd_exists_one(elt_year, elt_month, elt_day)) {
+      continue;
+    }
+
     unsigned int elt_date_month = static_cast<unsigned int>(elt_month);
     unsigned int elt_date_day = static_cast<unsigned int>(elt_day);
 
@@ -167,19 +432,10 @@ civil_writable_rcrd convert_year_month_day_to_local_fields(const cpp11::integers
       date::year{elt_year} / date::month{elt_date_month} / date::day{elt_date_day}
     };
 
-    if (!out_ymd.ok()) {
-      bool na = false;
-      resolve_day_nonexistent_ymd(i, day_nonexistent_val, out_ymd, na);
-
-      if (na) {
-        days[i] = r_int_na;
-        continue;
-      }
-    }
-
-    date::local_days out_lday{out_ymd};
+    bool na = false;
+    resolve_day_nonexistent_ymd(i, day_nonexistent_val, out_ymd, na);
 
-    days[i] = out_lday.time_since_epoch().count();
+    days[i] = na ? r_int_na : ymd_to_days_one(out_ymd);
   }
 
   return out;
@@ -202,6 +458,14 @@ civil_writable_rcrd convert_year_month_day_hour_minute_second_to_local_fields_cp
 
   civil_writable_rcrd out = new_days_time_of_day_list(days, time_of_day);
 
+  ymd_to_days(
+    civil_int_deref_const(year),
+    civil_int_deref_const(month),
+    civil_int_deref_const(day),
+    size,
+    civil_int_deref(days)
+  );
+
   for (r_ssize i = 0; i < size; ++i) {
     int elt_year = year[i];
     int elt_month = month[i];
@@ -233,14 +497,14 @@ civil_writable_rcrd convert_year_month_day_hour_minute_second_to_local_fields_cp
       std::chrono::minutes{elt_minute} +
       std::chrono::seconds{elt_second};
 
-    unsigned int elt_date_month = static_cast<unsigned int>(elt_month);
-    unsigned int elt_date_day = static_cast<unsigned int>(elt_day);
+    if (!ymd_exists_one(elt_year, elt_month, elt_day)) {
+      unsigned int elt_date_month = static_cast<unsigned int>(elt_month);
+      unsigned int elt_date_day = static_cast<unsigned int>(elt_day);
 
-    date::year_month_day out_ymd{
-      date::year{elt_year} / date::month{elt_date_month} / date::day{elt_date_day}
-    };
+      date::year_month_day out_ymd{
+        date::year{elt_year} / date::month{elt_date_month} / date::day{elt_date_day}
+      };
 
-    if (!out_ymd.ok()) {
       bool na = false;
       resolve_day_nonexistent_ymd(i, day_nonexistent_val, out_ymd, na);
       resolve_day_nonexistent_tod(day_nonexistent_val, out_tod);
@@ -250,11 +514,10 @@ civil_writable_rcrd convert_year_month_day_hour_minute_second_to_local_fields_cp
         time_of_day[i] = r_int_na;
         continue;
       }
-    }
 
-    date::local_days out_lday{out_ymd};
+      days[i] = ymd_to_days_one(out_ymd);
+    }
 
-    days[i] = out_lday.time_since_epoch().count();
     time_of_day[i] = out_tod.count();
   }
 
@@ -280,6 +543,14 @@ civil_writable_rcrd convert_year_month_day_hour_minute_second_nanos_to_local_fie
 
   civil_writable_rcrd out = new_days_time_of_day_nanos_of_second_list(days, time_of_day, nanos_of_second);
 
+  ymd_to_days(
+    civil_int_deref_const(year),
+    civil_int_deref_const(month),
+    civil_int_deref_const(day),
+    size,
+    civil_int_deref(days)
+  );
+
   for (r_ssize i = 0; i < size; ++i) {
     int elt_year = year[i];
     int elt_month = month[i];
@@ -317,14 +588,14 @@ civil_writable_rcrd convert_year_month_day_hour_minute_second_nanos_to_local_fie
       std::chrono::minutes{elt_minute} +
       std::chrono::seconds{elt_second};
 
-    unsigned int elt_date_month = static_cast<unsigned int>(elt_month);
-    unsigned int elt_date_day = static_cast<unsigned int>(elt_day);
+    if (!ymd_exists_one(elt_year, elt_month, elt_day)) {
+      unsigned int elt_date_month = static_cast<unsigned int>(elt_month);
+      unsigned int elt_date_day = static_cast<unsigned int>(elt_day);
 
-    date::year_month_day out_ymd{
-      date::year{elt_year} / date::month{elt_date_month} / date::day{elt_date_day}
-    };
+      date::year_month_day out_ymd{
+        date::year{elt_year} / date::month{elt_date_month} / date::day{elt_date_day}
+      };
 
-    if (!out_ymd.ok()) {
       bool na = false;
       resolve_day_nonexistent_ymd(i, day_nonexistent_val, out_ymd, na);
       resolve_day_nonexistent_tod(day_nonexistent_val, out_tod);
@@ -336,11 +607,10 @@ civil_writable_rcrd convert_year_month_day_hour_minute_second_nanos_to_local_fie
         nanos_of_second[i] = r_int_na;
         continue;
       }
-    }
 
-    date::local_days out_lday{out_ymd};
+      days[i] = ymd_to_days_one(out_ymd);
+    }
 
-    days[i] = out_lday.time_since_epoch().count();
     time_of_day[i] = out_tod.count();
     nanos_of_second[i] = out_nanos_of_second.count();
   }
@@ -350,270 +620,102 @@ civil_writable_rcrd convert_year_month_day_hour_minute_second_nanos_to_local_fie
 
 // -----------------------------------------------------------------------------
 
-[[cpp11::register]]
-civil_writable_list_of_integers convert_local_days_to_year_month_day_cpp(const civil_field& days) {
-  r_ssize size = days.size();
-
-  cpp11::writable::integers year(size);
-  cpp11::writable::integers month(size);
-  cpp11::writable::integers day(size);
-
-  civil_writable_list_of_integers out({year, month, day});
-  out.names() = {"year", "month", "day"};
-
-  for (r_ssize i = 0; i < size; ++i) {
-    int elt_days = days[i];
-
-    if (elt_days == r_int_na) {
-      year[i] = r_int_na;
-      month[i] = r_int_na;
-      day[i] = r_int_na;
-      continue;
-    }
-
-    date::local_days elt_lday{date::days{elt_days}};
-    date::year_month_day elt_ymd{elt_lday};
-
-    year[i] = static_cast<int>(elt_ymd.year());
-    month[i] = static_cast<unsigned int>(elt_ymd.month());
-    day[i] = static_cast<unsigned int>(elt_ymd.day());
-  }
-
-  return out;
-}
-
-[[cpp11::register]]
-civil_writable_list_of_integers convert_local_time_of_day_to_hour_minute_second_cpp(const civil_field& time_of_day) {
-  r_ssize size = time_of_day.size();
-
-  cpp11::writable::integers hour(size);
-  cpp11::writable::integers minute(size);
-  cpp11::writable::integers second(size);
-
-  civil_writable_list_of_integers out({hour, minute, second});
-  out.names() = {"hour", "minute", "second"};
-
-  for (r_ssize i = 0; i < size; ++i) {
-    int elt_time_of_day = time_of_day[i];
-
-    if (elt_time_of_day == r_int_na) {
-      hour[i] = r_int_na;
-      minute[i] = r_int_na;
-      second[i] = r_int_na;
-      continue;
-    }
-
-    std::chrono::seconds elt_tod_sec{elt_time_of_day};
-
-    date::hh_mm_ss<std::chrono::seconds> elt_hms = date::make_time(elt_tod_sec);
-
-    hour[i] = elt_hms.hours().count();
-    minute[i] = elt_hms.minutes().count();
-    second[i] = elt_hms.seconds().count();
-  }
-
-  return out;
-}
-
-// -----------------------------------------------------------------------------
-
 [[cpp11::register]]
 civil_writable_rcrd convert_datetime_fields_from_local_to_zoned_cpp(const civil_field& days,
                                                                     const civil_field& time_of_day,
                                                                     const cpp11::strings& zone,
-                                                                    const cpp11::strings& dst_nonexistent,
-                                                                    const cpp11::strings& dst_ambiguous,
+                                                                    const cpp11::integers& dst_nonexistent,
+                                                                    const cpp11::integers& dst_ambiguous,
                                                                     const cpp11::integers& size) {
   r_ssize c_size = size[0];
 
-  civil_writable_field out_days(c_size);
-  civil_writable_field out_time_of_day(c_size);
-
-  civil_writable_rcrd out = new_days_time_of_day_list(out_days, out_time_of_day);
-
-  bool recycle_days = civil_is_scalar(days);
-  bool recycle_time_of_day = civil_is_scalar(time_of_day);
-  bool recycle_dst_nonexistent = civil_is_scalar(dst_nonexistent);
-  bool recycle_dst_ambiguous = civil_is_scalar(dst_ambiguous);
-
-  enum dst_nonexistent dst_nonexistent_val;
-  if (recycle_dst_nonexistent) {
-    dst_nonexistent_val = parse_dst_nonexistent_one(dst_nonexistent[0]);
-  }
-
-  enum dst_ambiguous dst_ambiguous_val;
-  if (recycle_dst_ambiguous) {
-    dst_ambiguous_val = parse_dst_ambiguous_one(dst_ambiguous[0]);
-  }
-
-  cpp11::writable::strings zone_standard = zone_standardize(zone);
-  cpp11::r_string zone_name_r(zone_standard[0]);
-  std::string zone_name(zone_name_r);
-  const date::time_zone* p_time_zone = zone_name_load(zone_name);
-
-  for (r_ssize i = 0; i < c_size; ++i) {
-    int elt_days = recycle_days ? days[0] : days[i];
-    int elt_time_of_day = recycle_time_of_day ? time_of_day[0] : time_of_day[i];
-
-    const enum dst_nonexistent elt_dst_nonexistent_val =
-      recycle_dst_nonexistent ?
-      dst_nonexistent_val :
-      parse_dst_nonexistent_one(dst_nonexistent[i]);
-
-    const enum dst_ambiguous elt_dst_ambiguous_val =
-      recycle_dst_ambiguous ?
-      dst_ambiguous_val :
-      parse_dst_ambiguous_one(dst_ambiguous[i]);
+  fields_reader<std::chrono::seconds> x(days, time_of_day);
+  fields_writer<std::chrono::seconds> out(c_size);
 
-    if (elt_days == r_int_na) {
-      out_days[i] = r_int_na;
-      out_time_of_day[i] = r_int_na;
-      continue;
-    }
-
-    date::local_days elt_lday{date::days{elt_days}};
-    std::chrono::seconds elt_tod{elt_time_of_day};
-
-    date::local_seconds elt_lsec_floor{elt_lday};
-    date::local_seconds elt_lsec = elt_lsec_floor + elt_tod;
-
-    bool na = false;
+  zone_lookups lookups(zone, c_size);
 
-    date::sys_seconds out_ssec = convert_local_to_sys(
-      elt_lsec,
-      p_time_zone,
-      i,
-      elt_dst_nonexistent_val,
-      elt_dst_ambiguous_val,
-      na
-    );
-
-    if (na) {
-      out_days[i] = r_int_na;
-      out_time_of_day[i] = r_int_na;
-      continue;
-    }
-
-    date::sys_days out_sday = date::floor<date::days>(out_ssec);
-    date::sys_seconds out_ssec_floor{out_sday};
-
-    std::chrono::seconds out_tod{out_ssec - out_ssec_floor};
-
-    out_days[i] = out_sday.time_since_epoch().count();
-    out_time_of_day[i] = out_tod.count();
-  }
+  convert_datetime_from_local_to_zoned<std::chrono::seconds>(
+    x,
+    out,
+    c_size,
+    lookups,
+    dst_nonexistent,
+    dst_ambiguous
+  );
 
-  return out;
+  return out.result();
 }
 
-// -----------------------------------------------------------------------------
-
 [[cpp11::register]]
 civil_writable_rcrd convert_nano_datetime_fields_from_local_to_zoned_cpp(const civil_field& days,
                                                                          const civil_field& time_of_day,
                                                                          const civil_field& nanos_of_second,
                                                                          const cpp11::strings& zone,
-                                                                         const cpp11::strings& dst_nonexistent,
-                                                                         const cpp11::strings& dst_ambiguous,
+                                                                         const cpp11::integers& dst_nonexistent,
+                                                                         const cpp11::integers& dst_ambiguous,
                                                                          const cpp11::integers& size) {
   r_ssize c_size = size[0];
 
-  civil_writable_field out_days(c_size);
-  civil_writable_field out_time_of_day(c_size);
-  civil_writable_field out_nanos_of_second(c_size);
-
-  civil_writable_rcrd out = new_days_time_of_day_nanos_of_second_list(
-    out_days,
-    out_time_of_day,
-    out_nanos_of_second
-  );
-
-  bool recycle_days = civil_is_scalar(days);
-  bool recycle_time_of_day = civil_is_scalar(time_of_day);
-  bool recycle_nanos_of_second = civil_is_scalar(nanos_of_second);
-  bool recycle_dst_nonexistent = civil_is_scalar(dst_nonexistent);
-  bool recycle_dst_ambiguous = civil_is_scalar(dst_ambiguous);
-
-  enum dst_nonexistent dst_nonexistent_val;
-  if (recycle_dst_nonexistent) {
-    dst_nonexistent_val = parse_dst_nonexistent_one(dst_nonexistent[0]);
-  }
-
-  enum dst_ambiguous dst_ambiguous_val;
-  if (recycle_dst_ambiguous) {
-    dst_ambiguous_val = parse_dst_ambiguous_one(dst_ambiguous[0]);
-  }
-
-  cpp11::writable::strings zone_standard = zone_standardize(zone);
-  cpp11::r_string zone_name_r(zone_standard[0]);
-  std::string zone_name(zone_name_r);
-  const date::time_zone* p_time_zone = zone_name_load(zone_name);
+  fields_reader<std::chrono::nanoseconds> x(days, time_of_day, nanos_of_second);
+  fields_writer<std::chrono::nanoseconds> out(c_size);
 
-  for (r_ssize i = 0; i < c_size; ++i) {
-    int elt_days = recycle_days ? days[0] : days[i];
-    int elt_time_of_day = recycle_time_of_day ? time_of_day[0] : time_of_day[i];
-    int elt_nanos_of_second = recycle_nanos_of_second ? nanos_of_second[0] : nanos_of_second[i];
+  zone_lookups lookups(zone, c_size);
 
-    const enum dst_nonexistent elt_dst_nonexistent_val =
-      recycle_dst_nonexistent ?
-      dst_nonexistent_val :
-      parse_dst_nonexistent_one(dst_nonexistent[i]);
+  convert_datetime_from_local_to_zoned<std::chrono::nanoseconds>(
+    x,
+    out,
+    c_size,
+    lookups,
+    dst_nonexistent,
+    dst_ambiguous
+  );
 
-    const enum dst_ambiguous elt_dst_ambiguous_val =
-      recycle_dst_ambiguous ?
-      dst_ambiguous_val :
-      parse_dst_ambiguous_one(dst_ambiguous[i]);
+  return out.result();
+}
 
-    if (elt_days == r_int_na) {
-      out_days[i] = r_int_na;
-      out_time_of_day[i] = r_int_na;
-      out_nanos_of_second[i] = r_int_na;
-      continue;
-    }
+[[cpp11::register]]
+cpp11::writable::doubles convert_nano_datetime_count_from_local_to_zoned_cpp(const cpp11::doubles& x,
+                                                                             const cpp11::strings& zone,
+                                                                             const cpp11::integers& dst_nonexistent,
+                                                                             const cpp11::integers& dst_ambiguous,
+                                                                             const cpp11::integers& size) {
+  r_ssize c_size = size[0];
 
-    date::local_days elt_lday{date::days{elt_days}};
-    std::chrono::seconds elt_tod{elt_time_of_day};
-    std::chrono::nanoseconds elt_nanos{elt_nanos_of_second};
+  count_reader<std::chrono::nanoseconds> reader(x);
+  count_writer<std::chrono::nanoseconds> out(c_size);
 
-    date::local_seconds elt_lsec_floor{elt_lday};
-    date::local_seconds elt_lsec = elt_lsec_floor + elt_tod;
+  zone_lookups lookups(zone, c_size);
 
-    bool na = false;
+  convert_datetime_from_local_to_zoned<std::chrono::nanoseconds>(
+    reader,
+    out,
+    c_size,
+    lookups,
+    dst_nonexistent,
+    dst_ambiguous
+  );
 
-    date::sys_seconds out_ssec = convert_local_to_sys(
-      elt_lsec,
-      p_time_zone,
-      i,
-      elt_dst_nonexistent_val,
-      elt_dst_ambiguous_val,
-      na,
-      elt_nanos
-    );
-
-    if (na) {
-      out_days[i] = r_int_na;
-      out_time_of_day[i] = r_int_na;
-      out_nanos_of_second[i] = r_int_na;
-      continue;
-    }
+  return out.result();
+}
 
-    date::sys_days out_sday = date::floor<date::days>(out_ssec);
-    date::sys_seconds out_ssec_floor{out_sday};
+[[cpp11::register]]
+cpp11::writable::doubles convert_nano_datetime_count_from_zoned_to_local_cpp(const cpp11::doubles& x,
+                                                                             const cpp11::strings& zone) {
+  r_ssize size = x.size();
 
-    std::chrono::seconds out_tod{out_ssec - out_ssec_floor};
+  count_reader<std::chrono::nanoseconds> reader(x);
+  count_writer<std::chrono::nanoseconds> out(size);
 
-    std::chrono::nanoseconds out_nanos{elt_nanos};
+  zone_lookups lookups(zone, size);
 
-    out_days[i] = out_sday.time_since_epoch().count();
-    out_time_of_day[i] = out_tod.count();
-    out_nanos_of_second[i] = out_nanos.count();
-  }
+  convert_datetime_from_zoned_to_local<std::chrono::nanoseconds>(reader, out, size, lookups);
 
-  return out;
+  return out.result();
 }
 
 // -----------------------------------------------------------------------------
 
+
 /*
  * Same for datetime and nano_datetime, since nanoseconds wont change when
  * going from zoned->local. They are "beneath" time zone changes.
@@ -624,85 +726,117 @@ civil_writable_rcrd convert_datetime_fields_from_zoned_to_local_cpp(const civil_
                                                                     const cpp11::strings& zone) {
   r_ssize size = days.size();
 
-  civil_writable_field out_days(size);
-  civil_writable_field out_time_of_day(size);
+  fields_reader<std::chrono::seconds> x(days, time_of_day);
+  fields_writer<std::chrono::seconds> out(size);
 
-  civil_writable_rcrd out = new_days_time_of_day_list(
-    out_days,
-    out_time_of_day
-  );
+  zone_lookups lookups(zone, size);
+
+  convert_datetime_from_zoned_to_local<std::chrono::seconds>(x, out, size, lookups);
+
+  return out.result();
+}
 
-  cpp11::writable::strings zone_standard = zone_standardize(zone);
-  cpp11::r_string zone_name_r(zone_standard[0]);
-  std::string zone_name(zone_name_r);
-  const date::time_zone* p_time_zone = zone_name_load(zone_name);
+// -----------------------------------------------------------------------------
 
+/*
+ * Copies a datetime from one layout to another, see `layout.h`. No time zone
+ * is involved, so this works on sys and local datetimes alike.
+ */
+template <class Reader, class Writer>
+static void copy_datetime(const Reader& x, Writer& out, const r_ssize& size) {
   for (r_ssize i = 0; i < size; ++i) {
-    int elt_days = days[i];
-    int elt_time_of_day = time_of_day[i];
+    int64_t elt;
 
-    if (elt_days == r_int_na) {
-      out_days[i] = r_int_na;
-      out_time_of_day[i] = r_int_na;
+    if (!x.get(i, elt)) {
+      out.set_missing(i);
       continue;
     }
 
-    date::sys_days elt_sday{date::days{elt_days}};
-    std::chrono::seconds elt_tod{elt_time_of_day};
-
-    date::sys_seconds elt_ssec_floor{elt_sday};
-    date::sys_seconds elt_ssec = elt_ssec_floor + elt_tod;
-
-    date::zoned_seconds out_zsec = date::make_zoned(p_time_zone, elt_ssec);
-    date::local_seconds out_lsec = out_zsec.get_local_time();
+    out.set(i, elt);
+  }
+}
 
-    date::local_days out_lday = date::floor<date::days>(out_lsec);
-    date::local_seconds out_lsec_floor{out_lday};
+/*
+ * Reads the POSIXct in place, rather than stripping it to a bare double first
+ */
+[[cpp11::register]]
+civil_writable_rcrd convert_sys_seconds_to_sys_days_and_time_of_day_cpp(const cpp11::doubles& seconds) {
+  r_ssize size = seconds.size();
 
-    std::chrono::seconds out_tod{out_lsec - out_lsec_floor};
+  posixct_reader x(seconds);
+  fields_writer<std::chrono::seconds> out(size);
 
-    out_days[i] = out_lday.time_since_epoch().count();
-    out_time_of_day[i] = out_tod.count();
-  }
+  copy_datetime(x, out, size);
 
-  return out;
+  return out.result();
 }
 
 // -----------------------------------------------------------------------------
 
-[[cpp11::register]]
-civil_writable_rcrd convert_sys_seconds_to_sys_days_and_time_of_day_cpp(const cpp11::doubles& seconds) {
-  r_ssize size = seconds.size();
+/*
+ * Moves datetimes between the fields and count layouts, see `layout.h`
+ */
 
-  civil_writable_field out_days(size);
-  civil_writable_field out_time_of_day(size);
+template <class Duration>
+static cpp11::writable::doubles convert_datetime_fields_to_count(const civil_rcrd& fields) {
+  r_ssize size = fields[0].size();
 
-  civil_writable_rcrd out = new_days_time_of_day_list(
-    out_days,
-    out_time_of_day
-  );
+  fields_reader<Duration> x = fields.size() == 3 ?
+    fields_reader<Duration>(fields[0], fields[1], fields[2]) :
+    fields_reader<Duration>(fields[0], fields[1]);
+
+  count_writer<Duration> out(size);
+
+  // Stay clear of `INT64_MIN`, which is the missing value
+  const int64_t days_max = std::numeric_limits<int64_t>::max() / duration_per_day<Duration>() - 1;
 
   for (r_ssize i = 0; i < size; ++i) {
-    double elt_seconds = seconds[i];
-    int64_t elt = as_int64(elt_seconds);
+    const int elt_days = x.days(i);
 
-    if (elt == r_int64_na) {
-      out_days[i] = r_int_na;
-      out_time_of_day[i] = r_int_na;
+    if (elt_days == r_int_na) {
+      out.set_missing(i);
       continue;
     }
 
-    std::chrono::seconds elt_sec{elt};
-    date::sys_seconds elt_ssec{elt_sec};
+    if (elt_days > days_max || elt_days < -days_max) {
+      civil_abort("Datetime at location %i is too large to be stored as a count.", (int) i + 1);
+    }
+
+    int64_t elt;
+    x.get(i, elt);
+    out.set(i, elt);
+  }
+
+  return out.result();
+}
 
-    date::sys_days elt_sday = date::floor<date::days>(elt_ssec);
-    date::sys_seconds elt_ssec_floor{elt_sday};
+template <class Duration>
+static civil_writable_rcrd convert_datetime_count_to_fields(const cpp11::doubles& x) {
+  r_ssize size = x.size();
 
-    std::chrono::seconds elt_tod{elt_ssec - elt_ssec_floor};
+  count_reader<Duration> reader(x);
+  fields_writer<Duration> out(size);
 
-    out_days[i] = elt_sday.time_since_epoch().count();
-    out_time_of_day[i] = elt_tod.count();
+  copy_datetime(reader, out, size);
+
+  return out.result();
+}
+
+[[cpp11::register]]
+cpp11::writable::doubles convert_datetime_fields_to_count_cpp(const civil_rcrd& fields) {
+  switch (fields.size()) {
+  case 2: return convert_datetime_fields_to_count<std::chrono::seconds>(fields);
+  case 3: return convert_datetime_fields_to_count<std::chrono::nanoseconds>(fields);
+  default: civil_abort("`fields` must be the fields of a datetime or nano datetime.");
   }
+}
 
-  return out;
+[[cpp11::register]]
+civil_writable_rcrd convert_datetime_count_to_fields_cpp(const cpp11::doubles& x,
+                                                         const cpp11::strings& precision) {
+  switch (parse_unit(precision)) {
+  case unit::second: return convert_datetime_count_to_fields<std::chrono::seconds>(x);
+  case unit::nanosecond: return convert_datetime_count_to_fields<std::chrono::nanoseconds>(x);
+  default: civil_abort("`precision` must be either 'second' or 'nanosecond'.");
+  }
 }
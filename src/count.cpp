@@ -0,0 +1,199 @@
+#include "civil.h"
+#include "enums.h"
+#include "utils.h"
+#include "layout.h"
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Kernels for zoned nano datetimes in the count layout, see `layout.h`. They
+ * only read and write the one stream of counts, none of them splits a count
+ * into days and time of day.
+ */
+
+typedef count_reader<std::chrono::nanoseconds> nano_count_reader;
+typedef count_writer<std::chrono::nanoseconds> nano_count_writer;
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Compares `x` and `y` element wise, giving `-1`, `0` or `1`, or `NA` where
+ * either is missing. The counts are sys time, so their zones don't matter.
+ */
+[[cpp11::register]]
+cpp11::writable::integers datetime_count_compare_cpp(const cpp11::doubles& x,
+                                                     const cpp11::doubles& y,
+                                                     const cpp11::integers& size) {
+  const r_ssize c_size = size[0];
+
+  const nano_count_reader x_reader(x);
+  const nano_count_reader y_reader(y);
+
+  cpp11::writable::integers out(c_size);
+  int* p_out = civil_int_deref(out);
+
+  for (r_ssize i = 0; i < c_size; ++i) {
+    int64_t elt_x;
+    int64_t elt_y;
+
+    if (!x_reader.get(i, elt_x) || !y_reader.get(i, elt_y)) {
+      p_out[i] = r_int_na;
+      continue;
+    }
+
+    p_out[i] = (elt_x > elt_y) - (elt_x < elt_y);
+  }
+
+  return out;
+}
+
+/*
+ * Dense ranks of `x`, for `xtfrm()`. Equal counts share a rank and missing
+ * counts stay missing.
+ */
+[[cpp11::register]]
+cpp11::writable::integers datetime_count_rank_cpp(const cpp11::doubles& x) {
+  const r_ssize size = x.size();
+
+  const nano_count_reader reader(x);
+
+  cpp11::writable::integers out(size);
+  int* p_out = civil_int_deref(out);
+
+  std::vector<std::pair<int64_t, r_ssize>> elts;
+  elts.reserve(size);
+
+  for (r_ssize i = 0; i < size; ++i) {
+    int64_t elt;
+
+    if (!reader.get(i, elt)) {
+      p_out[i] = r_int_na;
+      continue;
+    }
+
+    elts.push_back(std::make_pair(elt, i));
+  }
+
+  std::sort(elts.begin(), elts.end());
+
+  int rank = 0;
+
+  for (size_t j = 0; j < elts.size(); ++j) {
+    if (j == 0 || elts[j].first != elts[j - 1].first) {
+      ++rank;
+    }
+
+    p_out[elts[j].second] = rank;
+  }
+
+  return out;
+}
+
+/*
+ * The high and low halves of each count as doubles, for the vctrs equality and
+ * comparison proxies. The halves are taken from the count with its sign bit
+ * flipped, so they order like the counts. The doubles that hold the counts
+ * can't be used directly, since the missing value has the bits of `-0` and
+ * every negative count is a `NaN`.
+ */
+[[cpp11::register]]
+cpp11::writable::list datetime_count_proxy_cpp(const cpp11::doubles& x) {
+  const r_ssize size = x.size();
+
+  const nano_count_reader reader(x);
+
+  cpp11::writable::doubles high(size);
+  cpp11::writable::doubles low(size);
+
+  double* p_high = civil_dbl_deref(high);
+  double* p_low = civil_dbl_deref(low);
+
+  for (r_ssize i = 0; i < size; ++i) {
+    int64_t elt;
+
+    if (!reader.get(i, elt)) {
+      p_high[i] = r_dbl_na;
+      p_low[i] = r_dbl_na;
+      continue;
+    }
+
+    const uint64_t elt_bits = static_cast<uint64_t>(elt) ^ (UINT64_C(1) << 63);
+
+    p_high[i] = static_cast<double>(elt_bits >> 32);
+    p_low[i] = static_cast<double>(elt_bits & UINT64_C(0xFFFFFFFF));
+  }
+
+  cpp11::writable::list out({high, low});
+  out.names() = {"high", "low"};
+
+  return out;
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Adds `n` units of `Unit` to each count. Like in
+ * `convert_datetime_fields_to_count()`, a result that doesn't fit in a count is
+ * an error rather than a missing value.
+ */
+template <class Unit>
+static cpp11::writable::doubles add_duration_count(const cpp11::doubles& x,
+                                                   const cpp11::integers& n,
+                                                   const r_ssize& size) {
+  const nano_count_reader reader(x);
+  nano_count_writer out(size);
+
+  const bool recycle_n = civil_is_scalar(n);
+  const int* p_n = civil_int_deref_const(n);
+
+  const int64_t per_unit = std::chrono::duration_cast<std::chrono::nanoseconds>(Unit{1}).count();
+
+  // Stay clear of `INT64_MIN`, which is the missing value
+  const int64_t max = std::numeric_limits<int64_t>::max();
+
+  for (r_ssize i = 0; i < size; ++i) {
+    int64_t elt_x;
+    const int elt_n = p_n[recycle_n ? 0 : i];
+
+    if (!reader.get(i, elt_x) || elt_n == r_int_na) {
+      out.set_missing(i);
+      continue;
+    }
+
+    if (elt_n > max / per_unit || elt_n < -max / per_unit) {
+      civil_abort("Datetime at location %i is too large to be stored as a count.", (int) i + 1);
+    }
+
+    const int64_t elt_by = elt_n * per_unit;
+
+    if (elt_by > 0 ? elt_x > max - elt_by : elt_x < -max - elt_by) {
+      civil_abort("Datetime at location %i is too large to be stored as a count.", (int) i + 1);
+    }
+
+    out.set(i, elt_x + elt_by);
+  }
+
+  return out.result();
+}
+
+[[cpp11::register]]
+cpp11::writable::doubles add_duration_count_cpp(const cpp11::doubles& x,
+                                                const cpp11::integers& n,
+                                                const cpp11::strings& unit,
+                                                const cpp11::integers& size) {
+  const r_ssize c_size = size[0];
+
+  switch (parse_unit(unit)) {
+  case unit::hour: return add_duration_count<std::chrono::hours>(x, n, c_size);
+  case unit::minute: return add_duration_count<std::chrono::minutes>(x, n, c_size);
+  case unit::second: return add_duration_count<std::chrono::seconds>(x, n, c_size);
+  case unit::millisecond: return add_duration_count<std::chrono::milliseconds>(x, n, c_size);
+  case unit::microsecond: return add_duration_count<std::chrono::microseconds>(x, n, c_size);
+  case unit::nanosecond: return add_duration_count<std::chrono::nanoseconds>(x, n, c_size);
+  default: civil_abort("Internal error: Unknown `unit` in `add_duration_count_cpp()`.");
+  }
+}
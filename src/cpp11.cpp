@@ -5,73 +5,87 @@
 #include "cpp11/declarations.hpp"
 
 // adjust.cpp
-civil_writable_rcrd adjust_local_days_cpp(const civil_rcrd& x, const cpp11::integers& value, const cpp11::strings& day_nonexistent, const cpp11::integers& size, const cpp11::strings& adjuster);
+civil_writable_rcrd adjust_local_days_cpp(SEXP x, const cpp11::integers& value, const cpp11::strings& day_nonexistent, const cpp11::integers& size, const cpp11::strings& adjuster);
 extern "C" SEXP _civil_adjust_local_days_cpp(SEXP x, SEXP value, SEXP day_nonexistent, SEXP size, SEXP adjuster) {
   BEGIN_CPP11
-    return cpp11::as_sexp(adjust_local_days_cpp(cpp11::as_cpp<cpp11::decay_t<const civil_rcrd&>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(value), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(day_nonexistent), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(adjuster)));
+    return cpp11::as_sexp(adjust_local_days_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(value), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(day_nonexistent), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(adjuster)));
   END_CPP11
 }
 // adjust.cpp
-civil_writable_rcrd adjust_local_time_of_day_cpp(const civil_rcrd& x, const cpp11::integers& value, const cpp11::integers& size, const cpp11::strings& adjuster);
+civil_writable_rcrd adjust_local_time_of_day_cpp(SEXP x, const cpp11::integers& value, const cpp11::integers& size, const cpp11::strings& adjuster);
 extern "C" SEXP _civil_adjust_local_time_of_day_cpp(SEXP x, SEXP value, SEXP size, SEXP adjuster) {
   BEGIN_CPP11
-    return cpp11::as_sexp(adjust_local_time_of_day_cpp(cpp11::as_cpp<cpp11::decay_t<const civil_rcrd&>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(value), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(adjuster)));
+    return cpp11::as_sexp(adjust_local_time_of_day_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(value), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(adjuster)));
   END_CPP11
 }
 // adjust.cpp
-civil_writable_rcrd adjust_local_nanos_of_second_cpp(const civil_rcrd& x, const cpp11::integers& value, const cpp11::integers& size, const cpp11::strings& adjuster);
+civil_writable_rcrd adjust_local_nanos_of_second_cpp(SEXP x, const cpp11::integers& value, const cpp11::integers& size, const cpp11::strings& adjuster);
 extern "C" SEXP _civil_adjust_local_nanos_of_second_cpp(SEXP x, SEXP value, SEXP size, SEXP adjuster) {
   BEGIN_CPP11
-    return cpp11::as_sexp(adjust_local_nanos_of_second_cpp(cpp11::as_cpp<cpp11::decay_t<const civil_rcrd&>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(value), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(adjuster)));
+    return cpp11::as_sexp(adjust_local_nanos_of_second_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(value), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(adjuster)));
   END_CPP11
 }
 // arithmetic.cpp
-civil_writable_rcrd add_years_or_months_local_cpp(const civil_rcrd& x, const cpp11::integers& n, const cpp11::strings& day_nonexistent, const cpp11::strings& unit, const cpp11::integers& size);
+civil_writable_rcrd add_years_or_months_local_cpp(SEXP x, const cpp11::integers& n, const cpp11::strings& day_nonexistent, const cpp11::strings& unit, const cpp11::integers& size);
 extern "C" SEXP _civil_add_years_or_months_local_cpp(SEXP x, SEXP n, SEXP day_nonexistent, SEXP unit, SEXP size) {
   BEGIN_CPP11
-    return cpp11::as_sexp(add_years_or_months_local_cpp(cpp11::as_cpp<cpp11::decay_t<const civil_rcrd&>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(n), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(day_nonexistent), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(unit), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size)));
+    return cpp11::as_sexp(add_years_or_months_local_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(n), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(day_nonexistent), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(unit), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size)));
   END_CPP11
 }
 // arithmetic.cpp
-civil_writable_rcrd add_weeks_or_days_local_cpp(const civil_rcrd& x, const cpp11::integers& n, const cpp11::strings& unit, const cpp11::integers& size);
+civil_writable_rcrd add_weeks_or_days_local_cpp(SEXP x, const cpp11::integers& n, const cpp11::strings& unit, const cpp11::integers& size);
 extern "C" SEXP _civil_add_weeks_or_days_local_cpp(SEXP x, SEXP n, SEXP unit, SEXP size) {
   BEGIN_CPP11
-    return cpp11::as_sexp(add_weeks_or_days_local_cpp(cpp11::as_cpp<cpp11::decay_t<const civil_rcrd&>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(n), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(unit), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size)));
+    return cpp11::as_sexp(add_weeks_or_days_local_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(n), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(unit), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size)));
   END_CPP11
 }
 // arithmetic.cpp
-civil_writable_rcrd add_hours_or_minutes_or_seconds_cpp(const civil_rcrd& x, const cpp11::integers& n, const cpp11::strings& unit, const cpp11::integers& size);
+civil_writable_rcrd add_hours_or_minutes_or_seconds_cpp(SEXP x, const cpp11::integers& n, const cpp11::strings& unit, const cpp11::integers& size);
 extern "C" SEXP _civil_add_hours_or_minutes_or_seconds_cpp(SEXP x, SEXP n, SEXP unit, SEXP size) {
   BEGIN_CPP11
-    return cpp11::as_sexp(add_hours_or_minutes_or_seconds_cpp(cpp11::as_cpp<cpp11::decay_t<const civil_rcrd&>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(n), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(unit), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size)));
+    return cpp11::as_sexp(add_hours_or_minutes_or_seconds_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(n), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(unit), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size)));
   END_CPP11
 }
 // arithmetic.cpp
-civil_writable_rcrd add_milliseconds_or_microseconds_or_nanoseconds_cpp(const civil_rcrd& x, const cpp11::integers& n, const cpp11::strings& unit, const cpp11::integers& size);
+civil_writable_rcrd add_milliseconds_or_microseconds_or_nanoseconds_cpp(SEXP x, const cpp11::integers& n, const cpp11::strings& unit, const cpp11::integers& size);
 extern "C" SEXP _civil_add_milliseconds_or_microseconds_or_nanoseconds_cpp(SEXP x, SEXP n, SEXP unit, SEXP size) {
   BEGIN_CPP11
-    return cpp11::as_sexp(add_milliseconds_or_microseconds_or_nanoseconds_cpp(cpp11::as_cpp<cpp11::decay_t<const civil_rcrd&>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(n), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(unit), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size)));
+    return cpp11::as_sexp(add_milliseconds_or_microseconds_or_nanoseconds_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(n), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(unit), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size)));
+  END_CPP11
+}
+// arithmetic.cpp
+civil_writable_rcrd add_calendar_zoned_cpp(SEXP x, const cpp11::integers& n, const cpp11::strings& zone, const cpp11::strings& day_nonexistent, const cpp11::integers& dst_nonexistent, const cpp11::integers& dst_ambiguous, const cpp11::strings& unit, const cpp11::integers& size);
+extern "C" SEXP _civil_add_calendar_zoned_cpp(SEXP x, SEXP n, SEXP zone, SEXP day_nonexistent, SEXP dst_nonexistent, SEXP dst_ambiguous, SEXP unit, SEXP size) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(add_calendar_zoned_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(n), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(day_nonexistent), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(dst_nonexistent), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(dst_ambiguous), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(unit), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size)));
+  END_CPP11
+}
+// civil-rcrd.cpp
+double civil_rcrd_reused_fields_cpp(const bool& reset);
+extern "C" SEXP _civil_civil_rcrd_reused_fields_cpp(SEXP reset) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(civil_rcrd_reused_fields_cpp(cpp11::as_cpp<cpp11::decay_t<const bool&>>(reset)));
   END_CPP11
 }
 // converters.cpp
-civil_writable_rcrd convert_sys_seconds_to_local_days_and_time_of_day(const cpp11::doubles& seconds, const cpp11::strings& zone);
-extern "C" SEXP _civil_convert_sys_seconds_to_local_days_and_time_of_day(SEXP seconds, SEXP zone) {
+civil_writable_rcrd convert_sys_seconds_to_local_days_and_time_of_day_cpp(const cpp11::doubles& seconds, const cpp11::strings& zone);
+extern "C" SEXP _civil_convert_sys_seconds_to_local_days_and_time_of_day_cpp(SEXP seconds, SEXP zone) {
   BEGIN_CPP11
-    return cpp11::as_sexp(convert_sys_seconds_to_local_days_and_time_of_day(cpp11::as_cpp<cpp11::decay_t<const cpp11::doubles&>>(seconds), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone)));
+    return cpp11::as_sexp(convert_sys_seconds_to_local_days_and_time_of_day_cpp(cpp11::as_cpp<cpp11::decay_t<const cpp11::doubles&>>(seconds), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone)));
   END_CPP11
 }
 // converters.cpp
-cpp11::writable::doubles convert_local_days_and_time_of_day_to_sys_seconds_cpp(const civil_field& days, const civil_field& time_of_day, const cpp11::strings& zone, const cpp11::strings& dst_nonexistent, const cpp11::strings& dst_ambiguous, const cpp11::integers& size);
+cpp11::writable::doubles convert_local_days_and_time_of_day_to_sys_seconds_cpp(const civil_field& days, const civil_field& time_of_day, const cpp11::strings& zone, const cpp11::integers& dst_nonexistent, const cpp11::integers& dst_ambiguous, const cpp11::integers& size);
 extern "C" SEXP _civil_convert_local_days_and_time_of_day_to_sys_seconds_cpp(SEXP days, SEXP time_of_day, SEXP zone, SEXP dst_nonexistent, SEXP dst_ambiguous, SEXP size) {
   BEGIN_CPP11
-    return cpp11::as_sexp(convert_local_days_and_time_of_day_to_sys_seconds_cpp(cpp11::as_cpp<cpp11::decay_t<const civil_field&>>(days), cpp11::as_cpp<cpp11::decay_t<const civil_field&>>(time_of_day), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(dst_nonexistent), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(dst_ambiguous), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size)));
+    return cpp11::as_sexp(convert_local_days_and_time_of_day_to_sys_seconds_cpp(cpp11::as_cpp<cpp11::decay_t<const civil_field&>>(days), cpp11::as_cpp<cpp11::decay_t<const civil_field&>>(time_of_day), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(dst_nonexistent), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(dst_ambiguous), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size)));
   END_CPP11
 }
 // converters.cpp
-civil_writable_rcrd convert_year_month_day_to_local_fields(const cpp11::integers& year, const cpp11::integers& month, const cpp11::integers& day, const cpp11::strings& day_nonexistent);
-extern "C" SEXP _civil_convert_year_month_day_to_local_fields(SEXP year, SEXP month, SEXP day, SEXP day_nonexistent) {
+civil_writable_rcrd convert_year_month_day_to_local_fields_cpp(const cpp11::integers& year, const cpp11::integers& month, const cpp11::integers& day, const cpp11::strings& day_nonexistent);
+extern "C" SEXP _civil_convert_year_month_day_to_local_fields_cpp(SEXP year, SEXP month, SEXP day, SEXP day_nonexistent) {
   BEGIN_CPP11
-    return cpp11::as_sexp(convert_year_month_day_to_local_fields(cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(year), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(month), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(day), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(day_nonexistent)));
+    return cpp11::as_sexp(convert_year_month_day_to_local_fields_cpp(cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(year), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(month), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(day), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(day_nonexistent)));
   END_CPP11
 }
 // converters.cpp
@@ -89,31 +103,31 @@ extern "C" SEXP _civil_convert_year_month_day_hour_minute_second_nanos_to_local_
   END_CPP11
 }
 // converters.cpp
-civil_writable_list_of_integers convert_local_days_to_year_month_day_cpp(const civil_field& days);
-extern "C" SEXP _civil_convert_local_days_to_year_month_day_cpp(SEXP days) {
+civil_writable_rcrd convert_datetime_fields_from_local_to_zoned_cpp(const civil_field& days, const civil_field& time_of_day, const cpp11::strings& zone, const cpp11::integers& dst_nonexistent, const cpp11::integers& dst_ambiguous, const cpp11::integers& size);
+extern "C" SEXP _civil_convert_datetime_fields_from_local_to_zoned_cpp(SEXP days, SEXP time_of_day, SEXP zone, SEXP dst_nonexistent, SEXP dst_ambiguous, SEXP size) {
   BEGIN_CPP11
-    return cpp11::as_sexp(convert_local_days_to_year_month_day_cpp(cpp11::as_cpp<cpp11::decay_t<const civil_field&>>(days)));
+    return cpp11::as_sexp(convert_datetime_fields_from_local_to_zoned_cpp(cpp11::as_cpp<cpp11::decay_t<const civil_field&>>(days), cpp11::as_cpp<cpp11::decay_t<const civil_field&>>(time_of_day), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(dst_nonexistent), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(dst_ambiguous), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size)));
   END_CPP11
 }
 // converters.cpp
-civil_writable_list_of_integers convert_local_time_of_day_to_hour_minute_second_cpp(const civil_field& time_of_day);
-extern "C" SEXP _civil_convert_local_time_of_day_to_hour_minute_second_cpp(SEXP time_of_day) {
+civil_writable_rcrd convert_nano_datetime_fields_from_local_to_zoned_cpp(const civil_field& days, const civil_field& time_of_day, const civil_field& nanos_of_second, const cpp11::strings& zone, const cpp11::integers& dst_nonexistent, const cpp11::integers& dst_ambiguous, const cpp11::integers& size);
+extern "C" SEXP _civil_convert_nano_datetime_fields_from_local_to_zoned_cpp(SEXP days, SEXP time_of_day, SEXP nanos_of_second, SEXP zone, SEXP dst_nonexistent, SEXP dst_ambiguous, SEXP size) {
   BEGIN_CPP11
-    return cpp11::as_sexp(convert_local_time_of_day_to_hour_minute_second_cpp(cpp11::as_cpp<cpp11::decay_t<const civil_field&>>(time_of_day)));
+    return cpp11::as_sexp(convert_nano_datetime_fields_from_local_to_zoned_cpp(cpp11::as_cpp<cpp11::decay_t<const civil_field&>>(days), cpp11::as_cpp<cpp11::decay_t<const civil_field&>>(time_of_day), cpp11::as_cpp<cpp11::decay_t<const civil_field&>>(nanos_of_second), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(dst_nonexistent), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(dst_ambiguous), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size)));
   END_CPP11
 }
 // converters.cpp
-civil_writable_rcrd convert_datetime_fields_from_local_to_zoned_cpp(const civil_field& days, const civil_field& time_of_day, const cpp11::strings& zone, const cpp11::strings& dst_nonexistent, const cpp11::strings& dst_ambiguous, const cpp11::integers& size);
-extern "C" SEXP _civil_convert_datetime_fields_from_local_to_zoned_cpp(SEXP days, SEXP time_of_day, SEXP zone, SEXP dst_nonexistent, SEXP dst_ambiguous, SEXP size) {
+cpp11::writable::doubles convert_nano_datetime_count_from_local_to_zoned_cpp(const cpp11::doubles& x, const cpp11::strings& zone, const cpp11::integers& dst_nonexistent, const cpp11::integers& dst_ambiguous, const cpp11::integers& size);
+extern "C" SEXP _civil_convert_nano_datetime_count_from_local_to_zoned_cpp(SEXP x, SEXP zone, SEXP dst_nonexistent, SEXP dst_ambiguous, SEXP size) {
   BEGIN_CPP11
-    return cpp11::as_sexp(convert_datetime_fields_from_local_to_zoned_cpp(cpp11::as_cpp<cpp11::decay_t<const civil_field&>>(days), cpp11::as_cpp<cpp11::decay_t<const civil_field&>>(time_of_day), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(dst_nonexistent), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(dst_ambiguous), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size)));
+    return cpp11::as_sexp(convert_nano_datetime_count_from_local_to_zoned_cpp(cpp11::as_cpp<cpp11::decay_t<const cpp11::doubles&>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(dst_nonexistent), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(dst_ambiguous), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size)));
   END_CPP11
 }
 // converters.cpp
-civil_writable_rcrd convert_nano_datetime_fields_from_local_to_zoned_cpp(const civil_field& days, const civil_field& time_of_day, const civil_field& nanos_of_second, const cpp11::strings& zone, const cpp11::strings& dst_nonexistent, const cpp11::strings& dst_ambiguous, const cpp11::integers& size);
-extern "C" SEXP _civil_convert_nano_datetime_fields_from_local_to_zoned_cpp(SEXP days, SEXP time_of_day, SEXP nanos_of_second, SEXP zone, SEXP dst_nonexistent, SEXP dst_ambiguous, SEXP size) {
+cpp11::writable::doubles convert_nano_datetime_count_from_zoned_to_local_cpp(const cpp11::doubles& x, const cpp11::strings& zone);
+extern "C" SEXP _civil_convert_nano_datetime_count_from_zoned_to_local_cpp(SEXP x, SEXP zone) {
   BEGIN_CPP11
-    return cpp11::as_sexp(convert_nano_datetime_fields_from_local_to_zoned_cpp(cpp11::as_cpp<cpp11::decay_t<const civil_field&>>(days), cpp11::as_cpp<cpp11::decay_t<const civil_field&>>(time_of_day), cpp11::as_cpp<cpp11::decay_t<const civil_field&>>(nanos_of_second), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(dst_nonexistent), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(dst_ambiguous), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size)));
+    return cpp11::as_sexp(convert_nano_datetime_count_from_zoned_to_local_cpp(cpp11::as_cpp<cpp11::decay_t<const cpp11::doubles&>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone)));
   END_CPP11
 }
 // converters.cpp
@@ -130,6 +144,48 @@ extern "C" SEXP _civil_convert_sys_seconds_to_sys_days_and_time_of_day_cpp(SEXP
     return cpp11::as_sexp(convert_sys_seconds_to_sys_days_and_time_of_day_cpp(cpp11::as_cpp<cpp11::decay_t<const cpp11::doubles&>>(seconds)));
   END_CPP11
 }
+// converters.cpp
+cpp11::writable::doubles convert_datetime_fields_to_count_cpp(const civil_rcrd& fields);
+extern "C" SEXP _civil_convert_datetime_fields_to_count_cpp(SEXP fields) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(convert_datetime_fields_to_count_cpp(cpp11::as_cpp<cpp11::decay_t<const civil_rcrd&>>(fields)));
+  END_CPP11
+}
+// converters.cpp
+civil_writable_rcrd convert_datetime_count_to_fields_cpp(const cpp11::doubles& x, const cpp11::strings& precision);
+extern "C" SEXP _civil_convert_datetime_count_to_fields_cpp(SEXP x, SEXP precision) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(convert_datetime_count_to_fields_cpp(cpp11::as_cpp<cpp11::decay_t<const cpp11::doubles&>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(precision)));
+  END_CPP11
+}
+// count.cpp
+cpp11::writable::integers datetime_count_compare_cpp(const cpp11::doubles& x, const cpp11::doubles& y, const cpp11::integers& size);
+extern "C" SEXP _civil_datetime_count_compare_cpp(SEXP x, SEXP y, SEXP size) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(datetime_count_compare_cpp(cpp11::as_cpp<cpp11::decay_t<const cpp11::doubles&>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::doubles&>>(y), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size)));
+  END_CPP11
+}
+// count.cpp
+cpp11::writable::integers datetime_count_rank_cpp(const cpp11::doubles& x);
+extern "C" SEXP _civil_datetime_count_rank_cpp(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(datetime_count_rank_cpp(cpp11::as_cpp<cpp11::decay_t<const cpp11::doubles&>>(x)));
+  END_CPP11
+}
+// count.cpp
+cpp11::writable::list datetime_count_proxy_cpp(const cpp11::doubles& x);
+extern "C" SEXP _civil_datetime_count_proxy_cpp(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(datetime_count_proxy_cpp(cpp11::as_cpp<cpp11::decay_t<const cpp11::doubles&>>(x)));
+  END_CPP11
+}
+// count.cpp
+cpp11::writable::doubles add_duration_count_cpp(const cpp11::doubles& x, const cpp11::integers& n, const cpp11::strings& unit, const cpp11::integers& size);
+extern "C" SEXP _civil_add_duration_count_cpp(SEXP x, SEXP n, SEXP unit, SEXP size) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(add_duration_count_cpp(cpp11::as_cpp<cpp11::decay_t<const cpp11::doubles&>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(n), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(unit), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size)));
+  END_CPP11
+}
 // floor.cpp
 civil_writable_field floor_days_to_year_month_cpp(const civil_field& days);
 extern "C" SEXP _civil_floor_days_to_year_month_cpp(SEXP days) {
@@ -137,6 +193,20 @@ extern "C" SEXP _civil_floor_days_to_year_month_cpp(SEXP days) {
     return cpp11::as_sexp(floor_days_to_year_month_cpp(cpp11::as_cpp<cpp11::decay_t<const civil_field&>>(days)));
   END_CPP11
 }
+// floor.cpp
+civil_writable_rcrd round_local_cpp(SEXP x, const cpp11::strings& rounding, const cpp11::strings& unit, const cpp11::integers& multiple, const cpp11::integers& week_start);
+extern "C" SEXP _civil_round_local_cpp(SEXP x, SEXP rounding, SEXP unit, SEXP multiple, SEXP week_start) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(round_local_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(rounding), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(unit), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(multiple), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(week_start)));
+  END_CPP11
+}
+// floor.cpp
+civil_writable_rcrd round_zoned_cpp(SEXP x, const cpp11::strings& zone, const cpp11::strings& rounding, const cpp11::strings& unit, const cpp11::integers& multiple, const cpp11::integers& week_start, const cpp11::integers& dst_nonexistent, const cpp11::integers& dst_ambiguous, const cpp11::integers& size);
+extern "C" SEXP _civil_round_zoned_cpp(SEXP x, SEXP zone, SEXP rounding, SEXP unit, SEXP multiple, SEXP week_start, SEXP dst_nonexistent, SEXP dst_ambiguous, SEXP size) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(round_zoned_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(rounding), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(unit), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(multiple), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(week_start), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(dst_nonexistent), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(dst_ambiguous), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size)));
+  END_CPP11
+}
 // format.cpp
 cpp11::writable::strings format_civil_rcrd_cpp(const civil_field& days, const civil_field& time_of_day, const civil_field& nanos_of_second, const cpp11::strings& zone, const cpp11::strings& format, const bool& local, const bool& nano, const bool& abbreviate_zone);
 extern "C" SEXP _civil_format_civil_rcrd_cpp(SEXP days, SEXP time_of_day, SEXP nanos_of_second, SEXP zone, SEXP format, SEXP local, SEXP nano, SEXP abbreviate_zone) {
@@ -151,6 +221,20 @@ extern "C" SEXP _civil_get_offset_cpp(SEXP days, SEXP time_of_day, SEXP zone) {
     return cpp11::as_sexp(get_offset_cpp(cpp11::as_cpp<cpp11::decay_t<const civil_field&>>(days), cpp11::as_cpp<cpp11::decay_t<const civil_field&>>(time_of_day), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone)));
   END_CPP11
 }
+// getters.cpp
+cpp11::writable::integers get_offset_posixct_cpp(const cpp11::doubles& x, const cpp11::strings& zone);
+extern "C" SEXP _civil_get_offset_posixct_cpp(SEXP x, SEXP zone) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(get_offset_posixct_cpp(cpp11::as_cpp<cpp11::decay_t<const cpp11::doubles&>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone)));
+  END_CPP11
+}
+// getters.cpp
+cpp11::writable::list get_local_components_cpp(const civil_rcrd& x, const cpp11::integers& components);
+extern "C" SEXP _civil_get_local_components_cpp(SEXP x, SEXP components) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(get_local_components_cpp(cpp11::as_cpp<cpp11::decay_t<const civil_rcrd&>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(components)));
+  END_CPP11
+}
 // install.cpp
 void civil_set_install(const cpp11::strings& path);
 extern "C" SEXP _civil_civil_set_install(SEXP path) {
@@ -159,11 +243,19 @@ extern "C" SEXP _civil_civil_set_install(SEXP path) {
     return R_NilValue;
   END_CPP11
 }
+// install.cpp
+void civil_write_tzdb_cache(const cpp11::strings& install, const cpp11::strings& path);
+extern "C" SEXP _civil_civil_write_tzdb_cache(SEXP install, SEXP path) {
+  BEGIN_CPP11
+    civil_write_tzdb_cache(cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(install), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(path));
+    return R_NilValue;
+  END_CPP11
+}
 // parse.cpp
-civil_writable_rcrd parse_zoned_datetime_cpp(const cpp11::strings& x, const cpp11::strings& format, const cpp11::strings& zone, const cpp11::strings& dst_nonexistent, const cpp11::strings& dst_ambiguous, const cpp11::integers& size);
+civil_writable_rcrd parse_zoned_datetime_cpp(const cpp11::strings& x, const cpp11::strings& format, const cpp11::strings& zone, const cpp11::integers& dst_nonexistent, const cpp11::integers& dst_ambiguous, const cpp11::integers& size);
 extern "C" SEXP _civil_parse_zoned_datetime_cpp(SEXP x, SEXP format, SEXP zone, SEXP dst_nonexistent, SEXP dst_ambiguous, SEXP size) {
   BEGIN_CPP11
-    return cpp11::as_sexp(parse_zoned_datetime_cpp(cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(format), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(dst_nonexistent), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(dst_ambiguous), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size)));
+    return cpp11::as_sexp(parse_zoned_datetime_cpp(cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(format), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(dst_nonexistent), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(dst_ambiguous), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size)));
   END_CPP11
 }
 // parse.cpp
@@ -194,9 +286,33 @@ extern "C" SEXP _civil_zone_current() {
     return cpp11::as_sexp(zone_current());
   END_CPP11
 }
+// zone.cpp
+cpp11::writable::doubles zone_lookup_counts_cpp(const bool& reset);
+extern "C" SEXP _civil_zone_lookup_counts_cpp(SEXP reset) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(zone_lookup_counts_cpp(cpp11::as_cpp<cpp11::decay_t<const bool&>>(reset)));
+  END_CPP11
+}
+// zone.cpp
+void zone_set_local_index_cpp(const bool& enabled);
+extern "C" SEXP _civil_zone_set_local_index_cpp(SEXP enabled) {
+  BEGIN_CPP11
+    zone_set_local_index_cpp(cpp11::as_cpp<cpp11::decay_t<const bool&>>(enabled));
+    return R_NilValue;
+  END_CPP11
+}
+// plan.cpp
+civil_writable_rcrd run_local_plan_cpp(SEXP x, const cpp11::integers& steps, const cpp11::list_of<cpp11::integers>& values, const cpp11::integers& day_nonexistent, const cpp11::integers& size);
+extern "C" SEXP _civil_run_local_plan_cpp(SEXP x, SEXP steps, SEXP values, SEXP day_nonexistent, SEXP size) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(run_local_plan_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(steps), cpp11::as_cpp<cpp11::decay_t<const cpp11::list_of<cpp11::integers>&>>(values), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(day_nonexistent), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(size)));
+  END_CPP11
+}
 
 extern "C" {
 /* .Call calls */
+extern SEXP _civil_add_calendar_zoned_cpp(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP _civil_add_duration_count_cpp(SEXP, SEXP, SEXP, SEXP);
 extern SEXP _civil_add_hours_or_minutes_or_seconds_cpp(SEXP, SEXP, SEXP, SEXP);
 extern SEXP _civil_add_milliseconds_or_microseconds_or_nanoseconds_cpp(SEXP, SEXP, SEXP, SEXP);
 extern SEXP _civil_add_weeks_or_days_local_cpp(SEXP, SEXP, SEXP, SEXP);
@@ -204,28 +320,44 @@ extern SEXP _civil_add_years_or_months_local_cpp(SEXP, SEXP, SEXP, SEXP, SEXP);
 extern SEXP _civil_adjust_local_days_cpp(SEXP, SEXP, SEXP, SEXP, SEXP);
 extern SEXP _civil_adjust_local_nanos_of_second_cpp(SEXP, SEXP, SEXP, SEXP);
 extern SEXP _civil_adjust_local_time_of_day_cpp(SEXP, SEXP, SEXP, SEXP);
+extern SEXP _civil_civil_rcrd_reused_fields_cpp(SEXP);
 extern SEXP _civil_civil_set_install(SEXP);
+extern SEXP _civil_civil_write_tzdb_cache(SEXP, SEXP);
+extern SEXP _civil_convert_datetime_count_to_fields_cpp(SEXP, SEXP);
 extern SEXP _civil_convert_datetime_fields_from_local_to_zoned_cpp(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
 extern SEXP _civil_convert_datetime_fields_from_zoned_to_local_cpp(SEXP, SEXP, SEXP);
+extern SEXP _civil_convert_datetime_fields_to_count_cpp(SEXP);
 extern SEXP _civil_convert_local_days_and_time_of_day_to_sys_seconds_cpp(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
-extern SEXP _civil_convert_local_days_to_year_month_day_cpp(SEXP);
-extern SEXP _civil_convert_local_time_of_day_to_hour_minute_second_cpp(SEXP);
+extern SEXP _civil_convert_nano_datetime_count_from_local_to_zoned_cpp(SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP _civil_convert_nano_datetime_count_from_zoned_to_local_cpp(SEXP, SEXP);
 extern SEXP _civil_convert_nano_datetime_fields_from_local_to_zoned_cpp(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
-extern SEXP _civil_convert_sys_seconds_to_local_days_and_time_of_day(SEXP, SEXP);
+extern SEXP _civil_convert_sys_seconds_to_local_days_and_time_of_day_cpp(SEXP, SEXP);
 extern SEXP _civil_convert_sys_seconds_to_sys_days_and_time_of_day_cpp(SEXP);
 extern SEXP _civil_convert_year_month_day_hour_minute_second_nanos_to_local_fields_cpp(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
 extern SEXP _civil_convert_year_month_day_hour_minute_second_to_local_fields_cpp(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
-extern SEXP _civil_convert_year_month_day_to_local_fields(SEXP, SEXP, SEXP, SEXP);
+extern SEXP _civil_convert_year_month_day_to_local_fields_cpp(SEXP, SEXP, SEXP, SEXP);
+extern SEXP _civil_datetime_count_compare_cpp(SEXP, SEXP, SEXP);
+extern SEXP _civil_datetime_count_proxy_cpp(SEXP);
+extern SEXP _civil_datetime_count_rank_cpp(SEXP);
 extern SEXP _civil_floor_days_to_year_month_cpp(SEXP);
 extern SEXP _civil_format_civil_rcrd_cpp(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP _civil_get_local_components_cpp(SEXP, SEXP);
 extern SEXP _civil_get_offset_cpp(SEXP, SEXP, SEXP);
+extern SEXP _civil_get_offset_posixct_cpp(SEXP, SEXP);
 extern SEXP _civil_parse_local_datetime_cpp(SEXP, SEXP);
 extern SEXP _civil_parse_zoned_datetime_cpp(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP _civil_round_local_cpp(SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP _civil_round_zoned_cpp(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP _civil_run_local_plan_cpp(SEXP, SEXP, SEXP, SEXP, SEXP);
 extern SEXP _civil_zone_current();
 extern SEXP _civil_zone_is_valid(SEXP);
+extern SEXP _civil_zone_lookup_counts_cpp(SEXP);
+extern SEXP _civil_zone_set_local_index_cpp(SEXP);
 extern SEXP _civil_zone_standardize(SEXP);
 
 static const R_CallMethodDef CallEntries[] = {
+    {"_civil_add_calendar_zoned_cpp",                                              (DL_FUNC) &_civil_add_calendar_zoned_cpp,                                              8},
+    {"_civil_add_duration_count_cpp",                                              (DL_FUNC) &_civil_add_duration_count_cpp,                                              4},
     {"_civil_add_hours_or_minutes_or_seconds_cpp",                                 (DL_FUNC) &_civil_add_hours_or_minutes_or_seconds_cpp,                                 4},
     {"_civil_add_milliseconds_or_microseconds_or_nanoseconds_cpp",                 (DL_FUNC) &_civil_add_milliseconds_or_microseconds_or_nanoseconds_cpp,                 4},
     {"_civil_add_weeks_or_days_local_cpp",                                         (DL_FUNC) &_civil_add_weeks_or_days_local_cpp,                                         4},
@@ -233,31 +365,48 @@ static const R_CallMethodDef CallEntries[] = {
     {"_civil_adjust_local_days_cpp",                                               (DL_FUNC) &_civil_adjust_local_days_cpp,                                               5},
     {"_civil_adjust_local_nanos_of_second_cpp",                                    (DL_FUNC) &_civil_adjust_local_nanos_of_second_cpp,                                    4},
     {"_civil_adjust_local_time_of_day_cpp",                                        (DL_FUNC) &_civil_adjust_local_time_of_day_cpp,                                        4},
+    {"_civil_civil_rcrd_reused_fields_cpp",                                        (DL_FUNC) &_civil_civil_rcrd_reused_fields_cpp,                                        1},
     {"_civil_civil_set_install",                                                   (DL_FUNC) &_civil_civil_set_install,                                                   1},
+    {"_civil_civil_write_tzdb_cache",                                              (DL_FUNC) &_civil_civil_write_tzdb_cache,                                              2},
+    {"_civil_convert_datetime_count_to_fields_cpp",                                (DL_FUNC) &_civil_convert_datetime_count_to_fields_cpp,                                2},
     {"_civil_convert_datetime_fields_from_local_to_zoned_cpp",                     (DL_FUNC) &_civil_convert_datetime_fields_from_local_to_zoned_cpp,                     6},
     {"_civil_convert_datetime_fields_from_zoned_to_local_cpp",                     (DL_FUNC) &_civil_convert_datetime_fields_from_zoned_to_local_cpp,                     3},
+    {"_civil_convert_datetime_fields_to_count_cpp",                                (DL_FUNC) &_civil_convert_datetime_fields_to_count_cpp,                                1},
     {"_civil_convert_local_days_and_time_of_day_to_sys_seconds_cpp",               (DL_FUNC) &_civil_convert_local_days_and_time_of_day_to_sys_seconds_cpp,               6},
-    {"_civil_convert_local_days_to_year_month_day_cpp",                            (DL_FUNC) &_civil_convert_local_days_to_year_month_day_cpp,                            1},
-    {"_civil_convert_local_time_of_day_to_hour_minute_second_cpp",                 (DL_FUNC) &_civil_convert_local_time_of_day_to_hour_minute_second_cpp,                 1},
+    {"_civil_convert_nano_datetime_count_from_local_to_zoned_cpp",                 (DL_FUNC) &_civil_convert_nano_datetime_count_from_local_to_zoned_cpp,                 5},
+    {"_civil_convert_nano_datetime_count_from_zoned_to_local_cpp",                 (DL_FUNC) &_civil_convert_nano_datetime_count_from_zoned_to_local_cpp,                 2},
     {"_civil_convert_nano_datetime_fields_from_local_to_zoned_cpp",                (DL_FUNC) &_civil_convert_nano_datetime_fields_from_local_to_zoned_cpp,                7},
-    {"_civil_convert_sys_seconds_to_local_days_and_time_of_day",                   (DL_FUNC) &_civil_convert_sys_seconds_to_local_days_and_time_of_day,                   2},
+    {"_civil_convert_sys_seconds_to_local_days_and_time_of_day_cpp",               (DL_FUNC) &_civil_convert_sys_seconds_to_local_days_and_time_of_day_cpp,               2},
     {"_civil_convert_sys_seconds_to_sys_days_and_time_of_day_cpp",                 (DL_FUNC) &_civil_convert_sys_seconds_to_sys_days_and_time_of_day_cpp,                 1},
     {"_civil_convert_year_month_day_hour_minute_second_nanos_to_local_fields_cpp", (DL_FUNC) &_civil_convert_year_month_day_hour_minute_second_nanos_to_local_fields_cpp, 8},
     {"_civil_convert_year_month_day_hour_minute_second_to_local_fields_cpp",       (DL_FUNC) &_civil_convert_year_month_day_hour_minute_second_to_local_fields_cpp,       7},
-    {"_civil_convert_year_month_day_to_local_fields",                              (DL_FUNC) &_civil_convert_year_month_day_to_local_fields,                              4},
+    {"_civil_convert_year_month_day_to_local_fields_cpp",                          (DL_FUNC) &_civil_convert_year_month_day_to_local_fields_cpp,                          4},
+    {"_civil_datetime_count_compare_cpp",                                          (DL_FUNC) &_civil_datetime_count_compare_cpp,                                          3},
+    {"_civil_datetime_count_proxy_cpp",                                            (DL_FUNC) &_civil_datetime_count_proxy_cpp,                                            1},
+    {"_civil_datetime_count_rank_cpp",                                             (DL_FUNC) &_civil_datetime_count_rank_cpp,                                             1},
     {"_civil_floor_days_to_year_month_cpp",                                        (DL_FUNC) &_civil_floor_days_to_year_month_cpp,                                        1},
     {"_civil_format_civil_rcrd_cpp",                                               (DL_FUNC) &_civil_format_civil_rcrd_cpp,                                               8},
+    {"_civil_get_local_components_cpp",                                            (DL_FUNC) &_civil_get_local_components_cpp,                                            2},
     {"_civil_get_offset_cpp",                                                      (DL_FUNC) &_civil_get_offset_cpp,                                                      3},
+    {"_civil_get_offset_posixct_cpp",                                              (DL_FUNC) &_civil_get_offset_posixct_cpp,                                              2},
     {"_civil_parse_local_datetime_cpp",                                            (DL_FUNC) &_civil_parse_local_datetime_cpp,                                            2},
     {"_civil_parse_zoned_datetime_cpp",                                            (DL_FUNC) &_civil_parse_zoned_datetime_cpp,                                            6},
+    {"_civil_round_local_cpp",                                                     (DL_FUNC) &_civil_round_local_cpp,                                                     5},
+    {"_civil_round_zoned_cpp",                                                     (DL_FUNC) &_civil_round_zoned_cpp,                                                     9},
+    {"_civil_run_local_plan_cpp",                                                  (DL_FUNC) &_civil_run_local_plan_cpp,                                                  5},
     {"_civil_zone_current",                                                        (DL_FUNC) &_civil_zone_current,                                                        0},
     {"_civil_zone_is_valid",                                                       (DL_FUNC) &_civil_zone_is_valid,                                                       1},
+    {"_civil_zone_lookup_counts_cpp",                                              (DL_FUNC) &_civil_zone_lookup_counts_cpp,                                              1},
+    {"_civil_zone_set_local_index_cpp",                                            (DL_FUNC) &_civil_zone_set_local_index_cpp,                                            1},
     {"_civil_zone_standardize",                                                    (DL_FUNC) &_civil_zone_standardize,                                                    1},
     {NULL, NULL, 0}
 };
 }
 
+void civil_init_altrep(DllInfo* dll);
+
 extern "C" void R_init_civil(DllInfo* dll){
   R_registerRoutines(dll, NULL, CallEntries, NULL, NULL);
   R_useDynamicSymbols(dll, FALSE);
+  civil_init_altrep(dll);
 }
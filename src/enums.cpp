@@ -25,54 +25,6 @@ enum day_nonexistent parse_day_nonexistent(const cpp11::strings& x) {
 
 // -----------------------------------------------------------------------------
 
-// [[ include("enums.h") ]]
-enum dst_nonexistent parse_dst_nonexistent(const cpp11::strings& x) {
-  if (x.size() != 1) {
-    civil_abort("`dst_nonexistent` must be a string with length 1.");
-  }
-
-  return parse_dst_nonexistent_one(x[0]);
-}
-
-// [[ include("enums.h") ]]
-enum dst_nonexistent parse_dst_nonexistent_one(const cpp11::r_string& x) {
-  std::string string(x);
-
-  if (string == "roll-forward") return dst_nonexistent::roll_forward;
-  if (string == "roll-backward") return dst_nonexistent::roll_backward;
-  if (string == "shift-forward") return dst_nonexistent::shift_forward;
-  if (string == "shift-backward") return dst_nonexistent::shift_backward;
-  if (string == "NA") return dst_nonexistent::na;
-  if (string == "error") return dst_nonexistent::error;
-
-  civil_abort("'%s' is not a recognized `dst_nonexistent` option.", string.c_str());
-}
-
-// -----------------------------------------------------------------------------
-
-// [[ include("enums.h") ]]
-enum dst_ambiguous parse_dst_ambiguous(const cpp11::strings& x) {
-  if (x.size() != 1) {
-    civil_abort("`dst_ambiguous` must be a string with length 1.");
-  }
-
-  return parse_dst_ambiguous_one(x[0]);
-}
-
-// [[ include("enums.h") ]]
-enum dst_ambiguous parse_dst_ambiguous_one(const cpp11::r_string& x) {
-  std::string string(x);
-
-  if (string == "earliest") return dst_ambiguous::earliest;
-  if (string == "latest") return dst_ambiguous::latest;
-  if (string == "NA") return dst_ambiguous::na;
-  if (string == "error") return dst_ambiguous::error;
-
-  civil_abort("'%s' is not a recognized `dst_ambiguous` option.", string.c_str());
-}
-
-// -----------------------------------------------------------------------------
-
 // [[ include("enums.h") ]]
 enum unit parse_unit(const cpp11::strings& x) {
   if (x.size() != 1) {
@@ -116,3 +68,20 @@ enum adjuster parse_adjuster(const cpp11::strings& x) {
 
   civil_abort("'%s' is not a recognized `adjuster` option.", string.c_str());
 }
+
+// -----------------------------------------------------------------------------
+
+// [[ include("enums.h") ]]
+enum rounding parse_rounding(const cpp11::strings& x) {
+  if (x.size() != 1) {
+    civil_abort("`rounding` must be a string with length 1.");
+  }
+
+  std::string string = x[0];
+
+  if (string == "floor") return rounding::floor;
+  if (string == "ceiling") return rounding::ceiling;
+  if (string == "round") return rounding::round;
+
+  civil_abort("'%s' is not a recognized `rounding` option.", string.c_str());
+}
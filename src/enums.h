@@ -15,6 +15,13 @@ enum class day_nonexistent {
 
 enum day_nonexistent parse_day_nonexistent(const cpp11::strings& x);
 
+/*
+ * Local plans carry one `day_nonexistent` per step, see `encode_option()`
+ */
+static inline enum day_nonexistent day_nonexistent_from_code(int code) {
+  return static_cast<enum day_nonexistent>(code);
+}
+
 // -----------------------------------------------------------------------------
 
 enum class dst_nonexistent {
@@ -26,8 +33,14 @@ enum class dst_nonexistent {
   error
 };
 
-enum dst_nonexistent parse_dst_nonexistent(const cpp11::strings& x);
-enum dst_nonexistent parse_dst_nonexistent_one(const cpp11::r_string& x);
+/*
+ * Codes are validated on the R side, see `encode_option()`, so the
+ * `*_from_code()` helpers cast without checking. The enum orders have to match
+ * the options there.
+ */
+static inline enum dst_nonexistent dst_nonexistent_from_code(int code) {
+  return static_cast<enum dst_nonexistent>(code);
+}
 
 // -----------------------------------------------------------------------------
 
@@ -38,8 +51,9 @@ enum class dst_ambiguous {
   error
 };
 
-enum dst_ambiguous parse_dst_ambiguous(const cpp11::strings& x);
-enum dst_ambiguous parse_dst_ambiguous_one(const cpp11::r_string& x);
+static inline enum dst_ambiguous dst_ambiguous_from_code(int code) {
+  return static_cast<enum dst_ambiguous>(code);
+}
 
 // -----------------------------------------------------------------------------
 
@@ -73,5 +87,39 @@ enum class adjuster {
 
 enum adjuster parse_adjuster(const cpp11::strings& x);
 
+// -----------------------------------------------------------------------------
+
+enum class rounding {
+  floor,
+  ceiling,
+  round
+};
+
+enum rounding parse_rounding(const cpp11::strings& x);
+
+// -----------------------------------------------------------------------------
+
+/*
+ * In the order of `component_options` in `getters.R`, see `encode_option()`
+ */
+enum class component {
+  year,
+  quarter,
+  month,
+  day,
+  weekday,
+  day_of_year,
+  iso_year,
+  iso_week,
+  hour,
+  minute,
+  second,
+  nanosecond
+};
+
+static inline enum component component_from_code(int code) {
+  return static_cast<enum component>(code);
+}
+
 // -----------------------------------------------------------------------------
 #endif
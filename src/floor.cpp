@@ -1,4 +1,11 @@
 #include "civil.h"
+#include "utils.h"
+#include "enums.h"
+#include "civil-rcrd.h"
+#include "zone.h"
+#include "conversion.h"
+#include "layout.h"
+#include "ymd.h"
 
 [[cpp11::register]]
 civil_writable_field floor_days_to_year_month_cpp(const civil_field& days) {
@@ -6,25 +13,380 @@ civil_writable_field floor_days_to_year_month_cpp(const civil_field& days) {
 
   civil_writable_field out_days(size);
 
+  const int* p_days = civil_int_deref_const(days);
+  int* p_out_days = civil_int_deref(out_days);
+
+  // Decode the day of month straight into the output, then step back to the
+  // first of the month. Missing days give a missing day of month.
+  days_to_ymd(p_days, size, NULL, NULL, p_out_days);
+
+  for (r_ssize i = 0; i < size; ++i) {
+    const int elt_day = p_out_days[i];
+    p_out_days[i] = elt_day == r_int_na ? r_int_na : p_days[i] - elt_day + 1;
+  }
+
+  return out_days;
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * A local time as its day and the ticks of `Duration` into that day. Rounding
+ * works on these pairs rather than on one count since the epoch, which would
+ * overflow at nanosecond precision a few centuries from 1970.
+ */
+struct local_ticks {
+  int64_t days;
+  int64_t ticks;
+};
+
+static inline bool operator==(const local_ticks& x, const local_ticks& y) {
+  return x.days == y.days && x.ticks == y.ticks;
+}
+
+static inline int64_t floor_mod(const int64_t& x, const int64_t& n) {
+  const int64_t out = x % n;
+  return out < 0 ? out + n : out;
+}
+static inline int64_t floor_div(const int64_t& x, const int64_t& n) {
+  return (x - floor_mod(x, n)) / n;
+}
+
+/*
+ * `x - y`, normalised so the ticks are within a day. Only used to compare
+ * distances, so it can't overflow however far apart the bounds are.
+ */
+static inline local_ticks local_ticks_minus(const local_ticks& x,
+                                            const local_ticks& y,
+                                            const int64_t& per_day) {
+  local_ticks out{x.days - y.days, x.ticks - y.ticks};
+
+  if (out.ticks < 0) {
+    out.ticks += per_day;
+    --out.days;
+  }
+
+  return out;
+}
+static inline bool local_ticks_less(const local_ticks& x, const local_ticks& y) {
+  return x.days < y.days || (x.days == y.days && x.ticks < y.ticks);
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * How to round to `multiple` units of `unit_val`, worked out once per call.
+ *
+ * Fixed width units, days and shorter, round with integer arithmetic on the
+ * units since `origin`, which is 1970-01-01 for everything but weeks. Weeks
+ * are days in multiples of 7 from the first `week_start` day on or after
+ * 1970-01-01. Only months and years decompose the days into a year, month,
+ * and day. Multiples of those count from January of year 0.
+ */
+template <class Duration>
+class rounder {
+public:
+  rounder(const enum unit& unit_val, const int& multiple, const int& week_start);
+
+  void bounds(const local_ticks& x, local_ticks& lower, local_ticks& upper) const;
+
+private:
+  int64_t per_day_;
+  bool calendar_;
+  bool year_;
+
+  // For fixed width units
+  int64_t size_;
+  int64_t per_day_units_;
+  int64_t origin_;
+
+  int64_t multiple_;
+};
+
+template <class Duration>
+inline rounder<Duration>::rounder(const enum unit& unit_val,
+                                  const int& multiple,
+                                  const int& week_start)
+  : per_day_(duration_per_day<Duration>()),
+    calendar_(unit_val == unit::year || unit_val == unit::month),
+    year_(unit_val == unit::year),
+    size_(0),
+    per_day_units_(1),
+    origin_(0),
+    multiple_(multiple) {
+  if (multiple < 1) {
+    civil_abort("Internal error: `multiple` must be positive.");
+  }
+
+  switch (unit_val) {
+  case unit::year:
+  case unit::month: return;
+  case unit::week: {
+    // 1970-01-01 was a Thursday, the ISO weekday `4`
+    size_ = per_day_;
+    origin_ = floor_mod(week_start - 4, 7);
+    multiple_ = 7 * static_cast<int64_t>(multiple);
+    break;
+  }
+  case unit::day: size_ = per_day_; break;
+  case unit::hour: size_ = std::chrono::duration_cast<Duration>(std::chrono::hours{1}).count(); break;
+  case unit::minute: size_ = std::chrono::duration_cast<Duration>(std::chrono::minutes{1}).count(); break;
+  case unit::second: size_ = std::chrono::duration_cast<Duration>(std::chrono::seconds{1}).count(); break;
+  case unit::millisecond: size_ = std::chrono::duration_cast<Duration>(std::chrono::milliseconds{1}).count(); break;
+  case unit::microsecond: size_ = std::chrono::duration_cast<Duration>(std::chrono::microseconds{1}).count(); break;
+  case unit::nanosecond: size_ = std::chrono::duration_cast<Duration>(std::chrono::nanoseconds{1}).count(); break;
+  }
+
+  if (size_ == 0) {
+    civil_abort("Internal error: Can't round to a unit finer than the precision of `x`.");
+  }
+
+  per_day_units_ = per_day_ / size_;
+}
+
+/*
+ * The largest multiple at or before `x`, and the one after that
+ */
+template <class Duration>
+inline void rounder<Duration>::bounds(const local_ticks& x,
+                                      local_ticks& lower,
+                                      local_ticks& upper) const {
+  if (calendar_) {
+    int year;
+    int month;
+    int day;
+
+    days_to_ymd_one(static_cast<int>(x.days), year, month, day);
+
+    if (year_) {
+      const int64_t lower_year = year - floor_mod(year, multiple_);
+      const int64_t upper_year = lower_year + multiple_;
+
+      lower = local_ticks{ymd_to_days_one(static_cast<int>(lower_year), 1, 1), 0};
+      upper = local_ticks{ymd_to_days_one(static_cast<int>(upper_year), 1, 1), 0};
+    } else {
+      const int64_t months = static_cast<int64_t>(year) * 12 + month - 1;
+      const int64_t lower_months = months - floor_mod(months, multiple_);
+      const int64_t upper_months = lower_months + multiple_;
+
+      lower = local_ticks{
+        ymd_to_days_one(static_cast<int>(floor_div(lower_months, 12)), static_cast<int>(floor_mod(lower_months, 12)) + 1, 1),
+        0
+      };
+      upper = local_ticks{
+        ymd_to_days_one(static_cast<int>(floor_div(upper_months, 12)), static_cast<int>(floor_mod(upper_months, 12)) + 1, 1),
+        0
+      };
+    }
+
+    return;
+  }
+
+  // The units since `origin`, modulo the multiple, without forming that count.
+  // Every factor here is below the multiple, so nothing overflows.
+  const int64_t units_of_day = x.ticks / size_;
+  const int64_t remainder = (
+    floor_mod(x.days - origin_, multiple_) * (per_day_units_ % multiple_) +
+    units_of_day % multiple_
+  ) % multiple_;
+
+  lower.days = x.days - remainder / per_day_units_;
+  lower.ticks = x.ticks - x.ticks % size_ - (remainder % per_day_units_) * size_;
+
+  if (lower.ticks < 0) {
+    lower.ticks += per_day_;
+    --lower.days;
+  }
+
+  upper.days = lower.days + multiple_ / per_day_units_;
+  upper.ticks = lower.ticks + (multiple_ % per_day_units_) * size_;
+
+  if (upper.ticks >= per_day_) {
+    upper.ticks -= per_day_;
+    ++upper.days;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template <class Duration>
+static inline local_ticks round_local_one(const local_ticks& x,
+                                          const rounder<Duration>& rounder_val,
+                                          const enum rounding& rounding_val) {
+  local_ticks lower;
+  local_ticks upper;
+
+  rounder_val.bounds(x, lower, upper);
+
+  switch (rounding_val) {
+  case rounding::floor: {
+    return lower;
+  }
+  case rounding::ceiling: {
+    return x == lower ? x : upper;
+  }
+  case rounding::round: {
+    // Halfway rounds up
+    const int64_t per_day = duration_per_day<Duration>();
+    const local_ticks below = local_ticks_minus(x, lower, per_day);
+    const local_ticks above = local_ticks_minus(upper, x, per_day);
+    return local_ticks_less(below, above) ? lower : upper;
+  }
+  }
+
+  never_reached("round_local_one");
+}
+
+/*
+ * `Duration` is the precision of `x`: days for dates and year-months, then
+ * seconds and nanoseconds for the datetimes. Rounding always resets the
+ * finer fields, so the result keeps the type of `x`.
+ */
+template <class Duration>
+static civil_writable_rcrd round_local(SEXP x,
+                                       const enum rounding& rounding_val,
+                                       const enum unit& unit_val,
+                                       const int& multiple,
+                                       const int& week_start) {
+  const r_ssize size = Rf_xlength(VECTOR_ELT(x, 0));
+
+  civil_writable_rcrd out = civil_rcrd_clone(x, size);
+
+  int* p_days = civil_rcrd_days_deref(out);
+  int* p_time_of_day = civil_rcrd_time_of_day_deref(out);
+  int* p_nanos_of_second = civil_rcrd_nanos_of_second_deref(out);
+
+  const rounder<Duration> rounder_val(unit_val, multiple, week_start);
+  const int64_t per_second = duration_per_second<Duration>();
+
   for (r_ssize i = 0; i < size; ++i) {
-    int elt_days = days[i];
+    const int elt_days = p_days[i];
 
     if (elt_days == r_int_na) {
-      out_days[i] = r_int_na;
       continue;
     }
 
-    date::local_days elt_lday{date::days{elt_days}};
-    date::year_month_day elt_ymd{elt_lday};
+    local_ticks elt{elt_days, 0};
 
-    date::year_month_day out_ymd{
-      elt_ymd.year() / elt_ymd.month() / date::day{1}
-    };
+    if (p_time_of_day != NULL) {
+      elt.ticks = p_time_of_day[i] * per_second;
+    }
+    if (p_nanos_of_second != NULL) {
+      elt.ticks += p_nanos_of_second[i];
+    }
 
-    date::local_days out_lday{out_ymd};
+    const local_ticks out_elt = round_local_one(elt, rounder_val, rounding_val);
 
-    out_days[i] = out_lday.time_since_epoch().count();
+    p_days[i] = static_cast<int>(out_elt.days);
+
+    if (p_time_of_day != NULL) {
+      p_time_of_day[i] = static_cast<int>(out_elt.ticks / per_second);
+    }
+    if (p_nanos_of_second != NULL) {
+      p_nanos_of_second[i] = static_cast<int>(out_elt.ticks % per_second);
+    }
   }
 
-  return out_days;
+  return out;
+}
+
+[[cpp11::register]]
+civil_writable_rcrd round_local_cpp(SEXP x,
+                                    const cpp11::strings& rounding,
+                                    const cpp11::strings& unit,
+                                    const cpp11::integers& multiple,
+                                    const cpp11::integers& week_start) {
+  const enum rounding rounding_val = parse_rounding(rounding);
+  const enum unit unit_val = parse_unit(unit);
+
+  switch (Rf_xlength(x)) {
+  case 1: return round_local<date::days>(x, rounding_val, unit_val, multiple[0], week_start[0]);
+  case 2: return round_local<std::chrono::seconds>(x, rounding_val, unit_val, multiple[0], week_start[0]);
+  case 3: return round_local<std::chrono::nanoseconds>(x, rounding_val, unit_val, multiple[0], week_start[0]);
+  default: civil_abort("Internal error: `x` must be a local date, datetime, or nano datetime.");
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Rounding of zoned datetimes and nano datetimes, fused into one pass. Each
+ * element goes from sys time to local time through its zone lookup, is
+ * rounded in local time, and goes back to sys time through the same lookup
+ * with the DST policies. The lookup caches the transitions around the last
+ * element, so a vector bucketed by day mostly never leaves that cache, even
+ * when a rounded time lands on the other side of a transition.
+ */
+template <class Duration>
+static civil_writable_rcrd round_zoned(SEXP x,
+                                       const cpp11::strings& zone,
+                                       const enum rounding& rounding_val,
+                                       const enum unit& unit_val,
+                                       const int& multiple,
+                                       const int& week_start,
+                                       const cpp11::integers& dst_nonexistent,
+                                       const cpp11::integers& dst_ambiguous,
+                                       const r_ssize& size) {
+  civil_writable_rcrd out = civil_rcrd_clone(x, size);
+
+  zoned_fields fields(out, dst_nonexistent, dst_ambiguous);
+
+  const rounder<Duration> rounder_val(unit_val, multiple, week_start);
+  const int64_t per_second = duration_per_second<Duration>();
+
+  zone_lookups lookups(zone, size);
+
+  for (r_ssize i = 0; i < size; ++i) {
+    if (fields.is_missing(i)) {
+      continue;
+    }
+
+    zone_lookup& lookup = lookups[i];
+
+    // Zoned -> local
+    std::chrono::seconds elt_offset;
+    const date::local_seconds elt_lsec = fields.to_local(i, lookup, elt_offset);
+
+    const date::local_days elt_lday = date::floor<date::days>(elt_lsec);
+    const std::chrono::seconds elt_tod{elt_lsec - elt_lday};
+
+    local_ticks elt{elt_lday.time_since_epoch().count(), elt_tod.count() * per_second};
+    elt.ticks += fields.nanos_of_second(i).count();
+
+    // Round in local time
+    const local_ticks out_elt = round_local_one(elt, rounder_val, rounding_val);
+
+    const date::local_seconds out_lsec =
+      date::local_days{date::days{out_elt.days}} +
+      std::chrono::seconds{out_elt.ticks / per_second};
+
+    const std::chrono::nanoseconds out_nanos{out_elt.ticks % per_second};
+
+    // Local -> zoned. A rounded time in an overlap keeps the offset of `x`
+    // where it can, so that it can't land on the far side of `x`.
+    fields.assign(i, out_lsec, out_nanos, lookup, elt_offset);
+  }
+
+  return out;
+}
+
+[[cpp11::register]]
+civil_writable_rcrd round_zoned_cpp(SEXP x,
+                                    const cpp11::strings& zone,
+                                    const cpp11::strings& rounding,
+                                    const cpp11::strings& unit,
+                                    const cpp11::integers& multiple,
+                                    const cpp11::integers& week_start,
+                                    const cpp11::integers& dst_nonexistent,
+                                    const cpp11::integers& dst_ambiguous,
+                                    const cpp11::integers& size) {
+  const enum rounding rounding_val = parse_rounding(rounding);
+  const enum unit unit_val = parse_unit(unit);
+  const r_ssize c_size = size[0];
+
+  switch (Rf_xlength(x)) {
+  case 2: return round_zoned<std::chrono::seconds>(x, zone, rounding_val, unit_val, multiple[0], week_start[0], dst_nonexistent, dst_ambiguous, c_size);
+  case 3: return round_zoned<std::chrono::nanoseconds>(x, zone, rounding_val, unit_val, multiple[0], week_start[0], dst_nonexistent, dst_ambiguous, c_size);
+  default: civil_abort("Internal error: `x` must be a zoned datetime or nano datetime.");
+  }
 }
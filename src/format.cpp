@@ -6,6 +6,7 @@
 #include "civil-rcrd.h"
 #include "check.h"
 #include "zone.h"
+#include "ymd.h"
 #include <sstream>
 #include <locale>
 
@@ -51,9 +52,7 @@ cpp11::writable::strings format_civil_rcrd_cpp(const civil_field& days,
 
   cpp11::writable::strings out(size);
 
-  cpp11::writable::strings zone_standard = zone_standardize(zone);
-  std::string zone_name = cpp11::r_string(zone_standard[0]);
-  const date::time_zone* p_time_zone = zone_name_load(zone_name);
+  zone_lookups lookups(zone, size);
 
   if (format.size() != 1) {
     civil_abort("`format` must have size 1.");
@@ -65,14 +64,7 @@ cpp11::writable::strings format_civil_rcrd_cpp(const civil_field& days,
   std::basic_ostringstream<char> stream;
   stream.imbue(std::locale::classic());
 
-  std::string zone_name_print;
-  std::string* p_zone_name_print = nullptr;
-
-  if (!local) {
-    // If zoned, default printable zone name to full provided zone name
-    zone_name_print = (zone_name.size() == 0) ? zone_name_current() : zone_name;
-    p_zone_name_print = &zone_name_print;
-  }
+  const std::string* p_zone_name_print = nullptr;
 
   // Default to no offset, which might change if formatting a zoned datetime
   std::chrono::seconds offset;
@@ -100,14 +92,18 @@ cpp11::writable::strings format_civil_rcrd_cpp(const civil_field& days,
       date::sys_seconds elt_ssec_floor{elt_sday};
       date::sys_seconds elt_ssec{elt_ssec_floor + elt_stod};
 
-      date::sys_info info = p_time_zone->get_info(elt_ssec);
+      zone_lookup& lookup = lookups[i];
+      const date::sys_info& info = lookup.get_info(elt_ssec);
 
       offset = info.offset;
       p_offset = &offset;
 
       if (abbreviate_zone) {
-        zone_name_print = info.abbrev;
-        p_zone_name_print = &zone_name_print;
+        // Points at the zone's interned abbreviation, so nothing is copied
+        p_zone_name_print = &lookup.abbrev();
+      } else {
+        // Full zone name, with `""` already resolved to the current zone
+        p_zone_name_print = &lookups.name(i);
       }
 
       date::local_seconds elt_lsec{(elt_ssec + info.offset).time_since_epoch()};
@@ -123,7 +119,7 @@ cpp11::writable::strings format_civil_rcrd_cpp(const civil_field& days,
     // Reset flags
     stream.clear();
 
-    date::year_month_day elt_ymd{elt_lday};
+    date::year_month_day elt_ymd = days_to_ymd_one(elt_lday.time_since_epoch().count());
 
     if (nano) {
       int elt_nanos_of_second = nanos_of_second[i];
@@ -1,36 +1,244 @@
 #include "civil.h"
+#include "utils.h"
+#include "enums.h"
 #include "zone.h"
+#include "layout.h"
+#include "ymd.h"
+#include <cstring>
+
+/*
+ * Works off any sys seconds reader from `layout.h`, so a POSIXct can be read
+ * in place
+ */
+template <class Reader>
+static cpp11::writable::integers get_offset(const Reader& x,
+                                            const r_ssize& size,
+                                            const cpp11::strings& zone) {
+  zone_lookups lookups(zone, size);
+
+  cpp11::writable::integers out(size);
+  int* p_out = civil_int_deref(out);
+
+  for (r_ssize i = 0; i < size; ++i) {
+    int64_t elt;
+
+    if (!x.get(i, elt)) {
+      p_out[i] = r_int_na;
+      continue;
+    }
+
+    date::sys_seconds elt_ssec{std::chrono::seconds{elt}};
+
+    const date::sys_info& info = lookups[i].get_info(elt_ssec);
+
+    p_out[i] = info.offset.count();
+  }
+
+  return out;
+}
 
 [[cpp11::register]]
 cpp11::writable::integers get_offset_cpp(const civil_field& days,
                                          const civil_field& time_of_day,
                                          const cpp11::strings& zone) {
-  r_ssize size = days.size();
+  fields_reader<std::chrono::seconds> x(days, time_of_day);
+  return get_offset(x, days.size(), zone);
+}
 
-  cpp11::writable::strings zone_standard = zone_standardize(zone);
-  std::string zone_name = cpp11::r_string(zone_standard[0]);
-  const date::time_zone* p_time_zone = zone_name_load(zone_name);
+[[cpp11::register]]
+cpp11::writable::integers get_offset_posixct_cpp(const cpp11::doubles& x,
+                                                 const cpp11::strings& zone) {
+  posixct_reader reader(x);
+  return get_offset(reader, x.size(), zone);
+}
 
-  cpp11::writable::integers out(size);
+// -----------------------------------------------------------------------------
 
-  for (r_ssize i = 0; i < size; ++i) {
-    int elt_days = days[i];
-    int elt_time_of_day = time_of_day[i];
+/*
+ * Extracts only the requested components of local fields, in one pass over
+ * blocks of `YMD_BLOCK_SIZE` elements. The year, month, and day of a block are
+ * decoded once, and only when a requested component needs them. Then each
+ * requested component is filled from the block by its own loop, which keeps
+ * those loops free of branches.
+ *
+ * `components` are unique codes, see `component_options` on the R side. The
+ * result holds one integer vector per component, in the same order.
+ *
+ * The `days` field can be `NULL` when only time components are requested, and
+ * then the size comes from `time_of_day`.
+ */
+[[cpp11::register]]
+cpp11::writable::list get_local_components_cpp(const civil_rcrd& x,
+                                               const cpp11::integers& components) {
+  const bool has_days = x[0] != R_NilValue;
+  const r_ssize size = has_days ? Rf_xlength(x[0]) : Rf_xlength(x[1]);
+  const r_ssize n_components = components.size();
 
-    if (elt_days == r_int_na) {
-      out[i] = r_int_na;
-      continue;
+  const int* p_days = has_days ? civil_int_deref_const(x[0]) : NULL;
+  const int* p_time_of_day = x.size() < 2 ? NULL : civil_int_deref_const(x[1]);
+  const int* p_nanos_of_second = x.size() < 3 ? NULL : civil_int_deref_const(x[2]);
+
+  cpp11::writable::list out(n_components);
+
+  // Indexed by component, `NULL` unless it was requested
+  int* p_out[static_cast<int>(component::nanosecond) + 1] = {NULL};
+
+  for (r_ssize j = 0; j < n_components; ++j) {
+    const int code = components[j];
+
+    if (code < 0 || code > static_cast<int>(component::nanosecond)) {
+      civil_abort("Internal error: Unknown component code %i.", code);
+    }
+
+    const enum component component_val = component_from_code(code);
+
+    const bool time_component =
+      component_val == component::hour ||
+      component_val == component::minute ||
+      component_val == component::second;
+
+    if (time_component && p_time_of_day == NULL) {
+      civil_abort("Internal error: `x` must have a `time_of_day` field.");
+    }
+    if (!time_component && component_val != component::nanosecond && p_days == NULL) {
+      civil_abort("Internal error: `x` must have a `days` field.");
+    }
+    if (component_val == component::nanosecond && p_nanos_of_second == NULL) {
+      civil_abort("Internal error: `x` must have a `nanos_of_second` field.");
     }
 
-    date::sys_days elt_sday{date::days{elt_days}};
-    std::chrono::seconds elt_tod{elt_time_of_day};
+    cpp11::writable::integers elt(size);
+    p_out[code] = civil_int_deref(elt);
+    out[j] = elt;
+  }
 
-    date::sys_seconds elt_ssec_floor{elt_sday};
-    date::sys_seconds elt_ssec = elt_ssec_floor + elt_tod;
+  int* p_year = p_out[static_cast<int>(component::year)];
+  int* p_quarter = p_out[static_cast<int>(component::quarter)];
+  int* p_month = p_out[static_cast<int>(component::month)];
+  int* p_day = p_out[static_cast<int>(component::day)];
+  int* p_weekday = p_out[static_cast<int>(component::weekday)];
+  int* p_day_of_year = p_out[static_cast<int>(component::day_of_year)];
+  int* p_iso_year = p_out[static_cast<int>(component::iso_year)];
+  int* p_iso_week = p_out[static_cast<int>(component::iso_week)];
+  int* p_hour = p_out[static_cast<int>(component::hour)];
+  int* p_minute = p_out[static_cast<int>(component::minute)];
+  int* p_second = p_out[static_cast<int>(component::second)];
+  int* p_nanosecond = p_out[static_cast<int>(component::nanosecond)];
 
-    date::sys_info info = p_time_zone->get_info(elt_ssec);
+  const bool need_ymd =
+    p_year != NULL ||
+    p_quarter != NULL ||
+    p_month != NULL ||
+    p_day != NULL ||
+    p_day_of_year != NULL;
 
-    out[i] = info.offset.count();
+  int block_year[YMD_BLOCK_SIZE];
+  int block_month[YMD_BLOCK_SIZE];
+  int block_day[YMD_BLOCK_SIZE];
+
+  for (r_ssize start = 0; start < size; start += YMD_BLOCK_SIZE) {
+    const r_ssize n = size - start < YMD_BLOCK_SIZE ? size - start : YMD_BLOCK_SIZE;
+    const int* p_block_days = p_days == NULL ? NULL : p_days + start;
+
+    if (need_ymd) {
+      days_to_ymd(p_block_days, n, block_year, block_month, block_day);
+    }
+
+    if (p_year != NULL) {
+      std::memcpy(p_year + start, block_year, n * sizeof(int));
+    }
+    if (p_month != NULL) {
+      std::memcpy(p_month + start, block_month, n * sizeof(int));
+    }
+    if (p_day != NULL) {
+      std::memcpy(p_day + start, block_day, n * sizeof(int));
+    }
+
+    if (p_quarter != NULL) {
+      int* p_block = p_quarter + start;
+
+      for (r_ssize i = 0; i < n; ++i) {
+        const int elt_month = block_month[i];
+        p_block[i] = elt_month == r_int_na ? r_int_na : (elt_month + 2) / 3;
+      }
+    }
+
+    if (p_day_of_year != NULL) {
+      int* p_block = p_day_of_year + start;
+
+      for (r_ssize i = 0; i < n; ++i) {
+        const bool na = block_year[i] == r_int_na;
+
+        // Subtracting from a missing day would overflow, so use a placeholder
+        const int elt_days = na ? 0 : p_block_days[i];
+        const int elt_year = na ? 1970 : block_year[i];
+
+        const int elt_day_of_year = days_to_day_of_year_one(elt_days, elt_year);
+        p_block[i] = na ? r_int_na : elt_day_of_year;
+      }
+    }
+
+    if (p_weekday != NULL) {
+      int* p_block = p_weekday + start;
+
+      for (r_ssize i = 0; i < n; ++i) {
+        const int elt_days = p_block_days[i];
+        const int elt_weekday = days_to_iso_weekday_one(elt_days);
+        p_block[i] = elt_days == r_int_na ? r_int_na : elt_weekday;
+      }
+    }
+
+    if (p_iso_year != NULL || p_iso_week != NULL) {
+      for (r_ssize i = 0; i < n; ++i) {
+        const bool na = p_block_days[i] == r_int_na;
+        const int elt_days = na ? 0 : p_block_days[i];
+
+        int elt_iso_year;
+        int elt_iso_week;
+
+        days_to_iso_year_week_one(elt_days, elt_iso_year, elt_iso_week);
+
+        if (p_iso_year != NULL) {
+          p_iso_year[start + i] = na ? r_int_na : elt_iso_year;
+        }
+        if (p_iso_week != NULL) {
+          p_iso_week[start + i] = na ? r_int_na : elt_iso_week;
+        }
+      }
+    }
+
+    // The time of day is missing exactly where the days are
+    if (p_hour != NULL) {
+      const int* p_block_time_of_day = p_time_of_day + start;
+      int* p_block = p_hour + start;
+
+      for (r_ssize i = 0; i < n; ++i) {
+        const int elt_time_of_day = p_block_time_of_day[i];
+        p_block[i] = elt_time_of_day == r_int_na ? r_int_na : elt_time_of_day / 3600;
+      }
+    }
+    if (p_minute != NULL) {
+      const int* p_block_time_of_day = p_time_of_day + start;
+      int* p_block = p_minute + start;
+
+      for (r_ssize i = 0; i < n; ++i) {
+        const int elt_time_of_day = p_block_time_of_day[i];
+        p_block[i] = elt_time_of_day == r_int_na ? r_int_na : elt_time_of_day / 60 % 60;
+      }
+    }
+    if (p_second != NULL) {
+      const int* p_block_time_of_day = p_time_of_day + start;
+      int* p_block = p_second + start;
+
+      for (r_ssize i = 0; i < n; ++i) {
+        const int elt_time_of_day = p_block_time_of_day[i];
+        p_block[i] = elt_time_of_day == r_int_na ? r_int_na : elt_time_of_day % 60;
+      }
+    }
+
+    if (p_nanosecond != NULL) {
+      std::memcpy(p_nanosecond + start, p_nanos_of_second + start, n * sizeof(int));
+    }
   }
 
   return out;
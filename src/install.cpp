@@ -20,3 +20,27 @@ void civil_set_install(const cpp11::strings& path) {
   date::set_install(string_path);
 #endif
 }
+
+/*
+ * Called from `src/install.libs.R` while the package is being installed.
+ * Writes a binary copy of the text database at `install` to `path`. When a
+ * current copy sits in the tzdata directory, `init_tzdb()` memory maps it on
+ * first use rather than parsing the text files, which is otherwise the bulk
+ * of the cost of the first zoned operation in a session.
+ */
+[[cpp11::register]]
+void civil_write_tzdb_cache(const cpp11::strings& install, const cpp11::strings& path) {
+  if (install.size() != 1) {
+    civil_abort("Internal error: Time zone database installation path should have size 1.");
+  }
+  if (path.size() != 1) {
+    civil_abort("Internal error: Time zone database cache path should have size 1.");
+  }
+
+  std::string string_install(install[0]);
+  std::string string_path(path[0]);
+
+#if !USE_OS_TZDB
+  date::write_tzdb_cache(string_install, string_path);
+#endif
+}
@@ -0,0 +1,258 @@
+#ifndef CIVIL_LAYOUT_H
+#define CIVIL_LAYOUT_H
+
+#include "civil.h"
+#include "utils.h"
+#include "civil-rcrd.h"
+#include <cstring>
+#include <utility>
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Storage layouts for datetimes. Kernels that are templated over a layout see
+ * every element as a single 64-bit count of `Duration` since the epoch,
+ * however it is stored:
+ *
+ * - The fields layout is the usual record of `days` and `time_of_day`, plus
+ *   `nanos_of_second` for nanosecond precision. It is split and recombined
+ *   on every access.
+ *
+ * - The count layout is one double vector holding the bits of an `int64_t`
+ *   count, with `INT64_MIN` as the missing value, like bit64's integer64. It
+ *   is 8 bytes per element and a single stream, but nanosecond counts only
+ *   cover the years 1678 to 2261. Zoned nano counts are stored this way, see
+ *   `count.cpp`.
+ *
+ * Readers recycle scalar inputs, like the kernels themselves.
+ *
+ * A POSIXct can also be read and written as a count of seconds, see
+ * `posixct_reader` and `posixct_writer`.
+ */
+
+template <class Duration>
+static inline int64_t duration_per_day() {
+  return std::chrono::duration_cast<Duration>(date::days{1}).count();
+}
+template <class Duration>
+static inline int64_t duration_per_second() {
+  return std::chrono::duration_cast<Duration>(std::chrono::seconds{1}).count();
+}
+
+// -----------------------------------------------------------------------------
+
+template <class Duration>
+class fields_reader {
+public:
+  fields_reader(const civil_field& days,
+                const civil_field& time_of_day,
+                const civil_field& nanos_of_second)
+    : p_days_(civil_int_deref_const(days)),
+      p_time_of_day_(civil_int_deref_const(time_of_day)),
+      p_nanos_of_second_(civil_int_deref_const(nanos_of_second)),
+      recycle_days_(civil_is_scalar(days)),
+      recycle_time_of_day_(civil_is_scalar(time_of_day)),
+      recycle_nanos_of_second_(civil_is_scalar(nanos_of_second)) {}
+
+  fields_reader(const civil_field& days,
+                const civil_field& time_of_day)
+    : p_days_(civil_int_deref_const(days)),
+      p_time_of_day_(civil_int_deref_const(time_of_day)),
+      p_nanos_of_second_(NULL),
+      recycle_days_(civil_is_scalar(days)),
+      recycle_time_of_day_(civil_is_scalar(time_of_day)),
+      recycle_nanos_of_second_(true) {}
+
+  /*
+   * Returns `false` if element `i` is missing
+   */
+  bool get(const r_ssize& i, int64_t& x) const {
+    const int elt_days = p_days_[recycle_days_ ? 0 : i];
+
+    if (elt_days == r_int_na) {
+      return false;
+    }
+
+    const int elt_time_of_day = p_time_of_day_[recycle_time_of_day_ ? 0 : i];
+
+    x = elt_days * duration_per_day<Duration>() +
+      elt_time_of_day * duration_per_second<Duration>();
+
+    if (p_nanos_of_second_ != NULL) {
+      x += p_nanos_of_second_[recycle_nanos_of_second_ ? 0 : i];
+    }
+
+    return true;
+  }
+
+  int days(const r_ssize& i) const {
+    return p_days_[recycle_days_ ? 0 : i];
+  }
+
+private:
+  const int* p_days_;
+  const int* p_time_of_day_;
+  const int* p_nanos_of_second_;
+  bool recycle_days_;
+  bool recycle_time_of_day_;
+  bool recycle_nanos_of_second_;
+};
+
+template <class Duration>
+class fields_writer {
+public:
+  explicit fields_writer(const r_ssize& size)
+    : days_(size),
+      time_of_day_(size),
+      nanos_of_second_(has_nanos() ? size : 0),
+      p_days_(civil_int_deref(days_)),
+      p_time_of_day_(civil_int_deref(time_of_day_)),
+      p_nanos_of_second_(has_nanos() ? civil_int_deref(nanos_of_second_) : NULL) {}
+
+  void set(const r_ssize& i, const int64_t& x) {
+    const int64_t per_day = duration_per_day<Duration>();
+    const int64_t per_second = duration_per_second<Duration>();
+
+    int64_t elt_days = x / per_day;
+    int64_t elt_rest = x - elt_days * per_day;
+
+    if (elt_rest < 0) {
+      elt_rest += per_day;
+      --elt_days;
+    }
+
+    p_days_[i] = static_cast<int>(elt_days);
+    p_time_of_day_[i] = static_cast<int>(elt_rest / per_second);
+
+    if (p_nanos_of_second_ != NULL) {
+      p_nanos_of_second_[i] = static_cast<int>(elt_rest % per_second);
+    }
+  }
+
+  void set_missing(const r_ssize& i) {
+    civil_rcrd_assign_missing(i, p_days_, p_time_of_day_, p_nanos_of_second_);
+  }
+
+  civil_writable_rcrd result() {
+    if (has_nanos()) {
+      return new_days_time_of_day_nanos_of_second_list(days_, time_of_day_, nanos_of_second_);
+    } else {
+      return new_days_time_of_day_list(days_, time_of_day_);
+    }
+  }
+
+private:
+  civil_writable_field days_;
+  civil_writable_field time_of_day_;
+  civil_writable_field nanos_of_second_;
+  int* p_days_;
+  int* p_time_of_day_;
+  int* p_nanos_of_second_;
+
+  static bool has_nanos() {
+    return duration_per_second<Duration>() != 1;
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+static inline int64_t count_get(const double* p_x, const r_ssize& i) {
+  int64_t out;
+  std::memcpy(&out, p_x + i, sizeof(int64_t));
+  return out;
+}
+static inline void count_set(double* p_x, const r_ssize& i, const int64_t& x) {
+  std::memcpy(p_x + i, &x, sizeof(int64_t));
+}
+
+template <class Duration>
+class count_reader {
+public:
+  explicit count_reader(const cpp11::doubles& x)
+    : p_x_(civil_dbl_deref_const(x)),
+      recycle_(civil_is_scalar(x)) {}
+
+  bool get(const r_ssize& i, int64_t& x) const {
+    x = count_get(p_x_, recycle_ ? 0 : i);
+    return x != r_int64_na;
+  }
+
+private:
+  const double* p_x_;
+  bool recycle_;
+};
+
+template <class Duration>
+class count_writer {
+public:
+  explicit count_writer(const r_ssize& size)
+    : x_(size),
+      p_x_(civil_dbl_deref(x_)) {}
+
+  void set(const r_ssize& i, const int64_t& x) {
+    count_set(p_x_, i, x);
+  }
+
+  void set_missing(const r_ssize& i) {
+    count_set(p_x_, i, r_int64_na);
+  }
+
+  cpp11::writable::doubles result() {
+    return std::move(x_);
+  }
+
+private:
+  cpp11::writable::doubles x_;
+  double* p_x_;
+};
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Reads the seconds of a POSIXct in place. `get_offset()` and the conversions
+ * of a POSIXct to zoned and local datetimes take the POSIXct's own double
+ * buffer through this, rather than having it split into days and time of day
+ * fields first. Fractional seconds are truncated, like everywhere else a
+ * POSIXct comes in.
+ */
+class posixct_reader {
+public:
+  explicit posixct_reader(const cpp11::doubles& x)
+    : p_x_(civil_dbl_deref_const(x)) {}
+
+  bool get(const r_ssize& i, int64_t& x) const {
+    x = as_int64(p_x_[i]);
+    return x != r_int64_na;
+  }
+
+private:
+  const double* p_x_;
+};
+
+/*
+ * Writes sys seconds into the double buffer of a new POSIXct
+ */
+class posixct_writer {
+public:
+  explicit posixct_writer(const r_ssize& size)
+    : x_(size),
+      p_x_(civil_dbl_deref(x_)) {}
+
+  void set(const r_ssize& i, const int64_t& x) {
+    p_x_[i] = static_cast<double>(x);
+  }
+
+  void set_missing(const r_ssize& i) {
+    p_x_[i] = r_dbl_na;
+  }
+
+  cpp11::writable::doubles result() {
+    return std::move(x_);
+  }
+
+private:
+  cpp11::writable::doubles x_;
+  double* p_x_;
+};
+
+#endif
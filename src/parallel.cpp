@@ -0,0 +1,40 @@
+#include "parallel.h"
+#include "utils.h"
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Each thread gets at least this many elements. Below that, starting the
+ * threads costs more than the conversion itself.
+ */
+static const r_ssize civil_thread_min_size = 10000;
+
+/*
+ * The number of threads a kernel should use for `size` elements, from the
+ * `civil.threads` option. Threads are opt-in, so this is 1 when the option
+ * isn't set. Must be called on the main thread.
+ *
+ * Inputs too small for a second thread never look the option up.
+ */
+// [[ include("parallel.h") ]]
+int civil_threads(r_ssize size) {
+  if (size < 2 * civil_thread_min_size) {
+    return 1;
+  }
+
+  SEXP option = Rf_GetOption1(Rf_install("civil.threads"));
+
+  if (option == r_null) {
+    return 1;
+  }
+
+  const int n_threads = Rf_asInteger(option);
+
+  if (Rf_length(option) != 1 || n_threads == r_int_na || n_threads < 1) {
+    civil_abort("`civil.threads` must be a single positive integer.");
+  }
+
+  const r_ssize max_threads = std::max(size / civil_thread_min_size, (r_ssize) 1);
+
+  return static_cast<int>(std::min((r_ssize) n_threads, max_threads));
+}
@@ -0,0 +1,75 @@
+#ifndef CIVIL_PARALLEL_H
+#define CIVIL_PARALLEL_H
+
+#include "civil.h"
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+
+int civil_threads(r_ssize size);
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Splits `[0, size)` into `n_threads` contiguous chunks and calls
+ * `fn(begin, end)` on each of them from its own thread. The first chunk runs
+ * on the calling thread.
+ *
+ * `fn` must not touch the R API, so kernels hand it raw pointers that were
+ * taken on the main thread. It returns the index of the first element of its
+ * chunk that failed, or `-1` if there were none. Once every chunk is joined,
+ * the smallest failing index is returned, which is the element a serial loop
+ * would have stopped at. The caller then raises the error itself.
+ *
+ * Any exception thrown by a chunk is rethrown here after joining.
+ */
+template <class Fn>
+r_ssize parallel_for(r_ssize size, int n_threads, Fn fn) {
+  const r_ssize n_chunks = n_threads;
+  const r_ssize chunk_size = (size + n_chunks - 1) / n_chunks;
+
+  std::vector<r_ssize> failures(n_chunks, -1);
+  std::vector<std::exception_ptr> exceptions(n_chunks);
+  std::vector<std::thread> threads;
+  threads.reserve(n_chunks - 1);
+
+  auto run = [&](r_ssize chunk) {
+    const r_ssize begin = std::min(size, chunk * chunk_size);
+    const r_ssize end = std::min(size, begin + chunk_size);
+
+    try {
+      failures[chunk] = fn(begin, end);
+    } catch (...) {
+      exceptions[chunk] = std::current_exception();
+    }
+  };
+
+  for (r_ssize chunk = 1; chunk < n_chunks; ++chunk) {
+    threads.emplace_back(run, chunk);
+  }
+
+  run(0);
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  for (r_ssize chunk = 0; chunk < n_chunks; ++chunk) {
+    if (exceptions[chunk]) {
+      std::rethrow_exception(exceptions[chunk]);
+    }
+  }
+
+  for (r_ssize chunk = 0; chunk < n_chunks; ++chunk) {
+    if (failures[chunk] != -1) {
+      return failures[chunk];
+    }
+  }
+
+  return -1;
+}
+
+#endif
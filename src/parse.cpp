@@ -47,15 +47,16 @@ from_stream(std::basic_istream<CharT, Traits>& is,
 civil_writable_rcrd parse_zoned_datetime_cpp(const cpp11::strings& x,
                                              const cpp11::strings& format,
                                              const cpp11::strings& zone,
-                                             const cpp11::strings& dst_nonexistent,
-                                             const cpp11::strings& dst_ambiguous,
+                                             const cpp11::integers& dst_nonexistent,
+                                             const cpp11::integers& dst_ambiguous,
                                              const cpp11::integers& size) {
   r_ssize c_size = size[0];
 
   cpp11::writable::strings zone_standard = zone_standardize(zone);
   cpp11::r_string zone_name_r(zone_standard[0]);
   std::string zone_name(zone_name_r);
-  const date::time_zone* p_time_zone = zone_name_load(zone_name);
+  const civil_zone* p_time_zone = zone_name_load(zone_name);
+  zone_lookup lookup(p_time_zone);
 
   if (format.size() != 1) {
     civil_abort("`format` must have size 1.");
@@ -73,15 +74,8 @@ civil_writable_rcrd parse_zoned_datetime_cpp(const cpp11::strings& x,
   bool recycle_dst_nonexistent = civil_is_scalar(dst_nonexistent);
   bool recycle_dst_ambiguous = civil_is_scalar(dst_ambiguous);
 
-  enum dst_nonexistent dst_nonexistent_val;
-  if (recycle_dst_nonexistent) {
-    dst_nonexistent_val = parse_dst_nonexistent_one(dst_nonexistent[0]);
-  }
-
-  enum dst_ambiguous dst_ambiguous_val;
-  if (recycle_dst_ambiguous) {
-    dst_ambiguous_val = parse_dst_ambiguous_one(dst_ambiguous[0]);
-  }
+  const int* p_dst_nonexistent = civil_int_deref_const(dst_nonexistent);
+  const int* p_dst_ambiguous = civil_int_deref_const(dst_ambiguous);
 
   std::istringstream stream;
   stream.imbue(std::locale::classic());
@@ -113,26 +107,23 @@ civil_writable_rcrd parse_zoned_datetime_cpp(const cpp11::strings& x,
     }
 
     // Default to supplied time zone
-    const date::time_zone* p_elt_time_zone = p_time_zone;
+    const civil_zone* p_elt_time_zone = p_time_zone;
 
-    // Swap to string specific time zone if one exists and is valid
+    // Swap to string specific time zone if one exists and is valid.
+    // Ignore it if %Z isn't a real zone.
     if (!elt_zone.empty()) {
-      try {
-        p_elt_time_zone = date::locate_zone(elt_zone);
-      } catch (const std::runtime_error& error) {
-        // Ignore runtime error if %Z isn't a real zone
-      };
+      const civil_zone* p_elt_zone = zone_name_find(elt_zone);
+
+      if (p_elt_zone != NULL) {
+        p_elt_time_zone = p_elt_zone;
+      }
     }
 
     const enum dst_nonexistent elt_dst_nonexistent_val =
-      recycle_dst_nonexistent ?
-      dst_nonexistent_val :
-      parse_dst_nonexistent_one(dst_nonexistent[i]);
+      dst_nonexistent_from_code(p_dst_nonexistent[recycle_dst_nonexistent ? 0 : i]);
 
     const enum dst_ambiguous elt_dst_ambiguous_val =
-      recycle_dst_ambiguous ?
-      dst_ambiguous_val :
-      parse_dst_ambiguous_one(dst_ambiguous[i]);
+      dst_ambiguous_from_code(p_dst_ambiguous[recycle_dst_ambiguous ? 0 : i]);
 
     date::local_days elt_lday{elt_ymd};
     date::local_seconds elt_lsec_floor{elt_lday};
@@ -154,9 +145,12 @@ civil_writable_rcrd parse_zoned_datetime_cpp(const cpp11::strings& x,
       // zone either implicit in the string or supplied as `zone`.
       bool na = false;
 
+      // Only drops the cached interval if the zone actually changed
+      lookup.set_zone(p_elt_time_zone);
+
       out_ssec = convert_local_to_sys(
         elt_lsec,
-        p_elt_time_zone,
+        lookup,
         i,
         elt_dst_nonexistent_val,
         elt_dst_ambiguous_val,
@@ -0,0 +1,235 @@
+#include "civil.h"
+#include "utils.h"
+#include "enums.h"
+#include "resolve.h"
+#include "civil-rcrd.h"
+#include "check.h"
+#include "ymd.h"
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Steps of a local plan, in the order of `plan_steps` on the R side, see
+ * `encode_option()`
+ */
+enum class plan_step {
+  add_years,
+  add_months,
+  add_days,
+  adjust_year,
+  adjust_month,
+  adjust_day,
+  floor_year,
+  floor_month,
+  floor_day
+};
+
+static inline enum plan_step plan_step_from_code(int code) {
+  return static_cast<enum plan_step>(code);
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * The state of one element while a plan runs over it. The year-month-day is
+ * decoded from `days` only when a calendar step needs it, and `days` is
+ * re-encoded only when a day step needs it, so a chain of calendar steps
+ * decodes and encodes once.
+ */
+struct plan_state {
+  int days;
+  date::year_month_day ymd;
+  bool ymd_current;
+  bool days_current;
+  std::chrono::seconds tod;
+  std::chrono::nanoseconds nanos_of_second;
+  bool na;
+};
+
+static inline void plan_state_sync_ymd(plan_state& state) {
+  if (!state.ymd_current) {
+    state.ymd = days_to_ymd_one(state.days);
+    state.ymd_current = true;
+  }
+}
+static inline void plan_state_sync_days(plan_state& state) {
+  if (!state.days_current) {
+    state.days = ymd_to_days_one(state.ymd);
+    state.days_current = true;
+  }
+}
+
+/*
+ * Mirrors `convert_year_month_day_to_days_one()`, so each calendar step
+ * resolves a nonexistent day exactly like the standalone function would
+ */
+static inline void plan_state_set_ymd(const r_ssize& i,
+                                      const enum day_nonexistent& day_nonexistent_val,
+                                      date::year_month_day ymd,
+                                      plan_state& state) {
+  if (!ymd.ok()) {
+    resolve_day_nonexistent_ymd(i, day_nonexistent_val, ymd, state.na);
+
+    if (state.na) {
+      return;
+    }
+
+    resolve_day_nonexistent_tod(day_nonexistent_val, state.tod);
+    resolve_day_nonexistent_nanos_of_second(day_nonexistent_val, state.nanos_of_second);
+  }
+
+  state.ymd = ymd;
+  state.ymd_current = true;
+  state.days_current = false;
+}
+
+static inline void plan_state_step(const r_ssize& i,
+                                   const enum plan_step& step,
+                                   const int& value,
+                                   const enum day_nonexistent& day_nonexistent_val,
+                                   plan_state& state) {
+  switch (step) {
+  case plan_step::add_years: {
+    plan_state_sync_ymd(state);
+    return plan_state_set_ymd(i, day_nonexistent_val, state.ymd + date::years{value}, state);
+  }
+  case plan_step::add_months: {
+    plan_state_sync_ymd(state);
+    return plan_state_set_ymd(i, day_nonexistent_val, state.ymd + date::months{value}, state);
+  }
+  case plan_step::add_days: {
+    plan_state_sync_days(state);
+    state.days += value;
+    state.ymd_current = false;
+    return;
+  }
+  case plan_step::adjust_year: {
+    check_range_year(value, "value");
+    plan_state_sync_ymd(state);
+    return plan_state_set_ymd(i, day_nonexistent_val, date::year{value} / state.ymd.month() / state.ymd.day(), state);
+  }
+  case plan_step::adjust_month: {
+    check_range_month(value, "value");
+    plan_state_sync_ymd(state);
+    unsigned int month = static_cast<unsigned int>(value);
+    return plan_state_set_ymd(i, day_nonexistent_val, state.ymd.year() / date::month{month} / state.ymd.day(), state);
+  }
+  case plan_step::adjust_day: {
+    check_range_day(value, "value");
+    plan_state_sync_ymd(state);
+    unsigned int day = static_cast<unsigned int>(value);
+    return plan_state_set_ymd(i, day_nonexistent_val, state.ymd.year() / state.ymd.month() / date::day{day}, state);
+  }
+  case plan_step::floor_year: {
+    plan_state_sync_ymd(state);
+    state.tod = std::chrono::seconds{0};
+    state.nanos_of_second = std::chrono::nanoseconds{0};
+    return plan_state_set_ymd(i, day_nonexistent_val, state.ymd.year() / date::January / date::day{1}, state);
+  }
+  case plan_step::floor_month: {
+    plan_state_sync_ymd(state);
+    state.tod = std::chrono::seconds{0};
+    state.nanos_of_second = std::chrono::nanoseconds{0};
+    return plan_state_set_ymd(i, day_nonexistent_val, state.ymd.year() / state.ymd.month() / date::day{1}, state);
+  }
+  case plan_step::floor_day: {
+    state.tod = std::chrono::seconds{0};
+    state.nanos_of_second = std::chrono::nanoseconds{0};
+    return;
+  }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+static civil_writable_rcrd run_local_plan(SEXP x,
+                                          const std::vector<enum plan_step>& steps,
+                                          const cpp11::list_of<cpp11::integers>& values,
+                                          const std::vector<enum day_nonexistent>& day_nonexistents,
+                                          const r_ssize& size) {
+  civil_writable_rcrd out = civil_rcrd_clone(x, size);
+
+  int* p_days = civil_rcrd_days_deref(out);
+  int* p_time_of_day = civil_rcrd_time_of_day_deref(out);
+  int* p_nanos_of_second = civil_rcrd_nanos_of_second_deref(out);
+
+  const r_ssize n_steps = steps.size();
+
+  std::vector<const int*> p_values(n_steps);
+  std::vector<bool> recycle_values(n_steps);
+
+  for (r_ssize j = 0; j < n_steps; ++j) {
+    const cpp11::integers value = values[j];
+    p_values[j] = civil_int_deref_const(value);
+    recycle_values[j] = civil_is_scalar(value);
+  }
+
+  plan_state state;
+
+  for (r_ssize i = 0; i < size; ++i) {
+    int elt_days = p_days[i];
+
+    if (elt_days == r_int_na) {
+      continue;
+    }
+
+    state.days = elt_days;
+    state.ymd_current = false;
+    state.days_current = true;
+    state.tod = std::chrono::seconds{p_time_of_day == NULL ? 0 : p_time_of_day[i]};
+    state.nanos_of_second = std::chrono::nanoseconds{p_nanos_of_second == NULL ? 0 : p_nanos_of_second[i]};
+    state.na = false;
+
+    for (r_ssize j = 0; j < n_steps; ++j) {
+      int elt_value = p_values[j][recycle_values[j] ? 0 : i];
+
+      if (elt_value == r_int_na) {
+        state.na = true;
+        break;
+      }
+
+      plan_state_step(i, steps[j], elt_value, day_nonexistents[j], state);
+
+      if (state.na) {
+        break;
+      }
+    }
+
+    if (state.na) {
+      civil_rcrd_assign_missing(i, p_days, p_time_of_day, p_nanos_of_second);
+      continue;
+    }
+
+    plan_state_sync_days(state);
+
+    p_days[i] = state.days;
+
+    if (p_time_of_day != NULL) {
+      p_time_of_day[i] = state.tod.count();
+    }
+    if (p_nanos_of_second != NULL) {
+      p_nanos_of_second[i] = state.nanos_of_second.count();
+    }
+  }
+
+  return out;
+}
+
+[[cpp11::register]]
+civil_writable_rcrd run_local_plan_cpp(SEXP x,
+                                       const cpp11::integers& steps,
+                                       const cpp11::list_of<cpp11::integers>& values,
+                                       const cpp11::integers& day_nonexistent,
+                                       const cpp11::integers& size) {
+  const r_ssize n_steps = steps.size();
+
+  std::vector<enum plan_step> c_steps(n_steps);
+  std::vector<enum day_nonexistent> c_day_nonexistent(n_steps);
+
+  for (r_ssize j = 0; j < n_steps; ++j) {
+    c_steps[j] = plan_step_from_code(steps[j]);
+    c_day_nonexistent[j] = day_nonexistent_from_code(day_nonexistent[j]);
+  }
+
+  return run_local_plan(x, c_steps, values, c_day_nonexistent, size[0]);
+}
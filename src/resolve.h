@@ -5,6 +5,7 @@
 #include "utils.h"
 #include "enums.h"
 #include "civil-rcrd.h"
+#include "ymd.h"
 
 // -----------------------------------------------------------------------------
 
@@ -112,13 +113,12 @@ static inline void resolve_day_nonexistent_error(const r_ssize& i) {
 static inline void convert_year_month_day_to_days_one(const r_ssize& i,
                                                       const enum day_nonexistent& day_nonexistent_val,
                                                       date::year_month_day& ymd,
-                                                      int* p_days,
-                                                      int* p_time_of_day,
-                                                      int* p_nanos_of_second) {
+                                                      civil_rcrd_field& days,
+                                                      civil_rcrd_field& time_of_day,
+                                                      civil_rcrd_field& nanos_of_second) {
   // Simple case - convert to local_days, no changes to time-of-day
   if (ymd.ok()) {
-    date::local_days out_lday{ymd};
-    p_days[i] = out_lday.time_since_epoch().count();
+    days.set(i, ymd_to_days_one(ymd));
     return;
   }
 
@@ -126,24 +126,23 @@ static inline void convert_year_month_day_to_days_one(const r_ssize& i,
   resolve_day_nonexistent_ymd(i, day_nonexistent_val, ymd, na);
 
   if (na) {
-    civil_rcrd_assign_missing(i, p_days, p_time_of_day, p_nanos_of_second);
+    civil_rcrd_assign_missing(i, days, time_of_day, nanos_of_second);
     return;
   }
 
-  if (p_time_of_day != NULL) {
-    std::chrono::seconds elt_tod{p_time_of_day[i]};
+  if (time_of_day.exists()) {
+    std::chrono::seconds elt_tod{time_of_day[i]};
     resolve_day_nonexistent_tod(day_nonexistent_val, elt_tod);
-    p_time_of_day[i] = elt_tod.count();
+    time_of_day.set(i, elt_tod.count());
   }
 
-  if (p_nanos_of_second != NULL) {
-    std::chrono::nanoseconds elt_nanos_of_second{p_nanos_of_second[i]};
+  if (nanos_of_second.exists()) {
+    std::chrono::nanoseconds elt_nanos_of_second{nanos_of_second[i]};
     resolve_day_nonexistent_nanos_of_second(day_nonexistent_val, elt_nanos_of_second);
-    p_nanos_of_second[i] = elt_nanos_of_second.count();
+    nanos_of_second.set(i, elt_nanos_of_second.count());
   }
 
-  date::local_days out_lday{ymd};
-  p_days[i] = out_lday.time_since_epoch().count();
+  days.set(i, ymd_to_days_one(ymd));
 }
 
 // -----------------------------------------------------------------------------
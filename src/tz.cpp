@@ -84,6 +84,11 @@
 #endif  // _WIN32
 
 #include "date/tz_private.h"
+// civil-edit-start
+#if USE_OS_TZDB
+#  include "date/ptz.h"
+#endif
+// civil-edit-stop
 
 #ifdef __APPLE__
 #  include "date/ios.h"
@@ -156,6 +161,16 @@
 #  endif //!USE_SHELL_API
 #endif  // !_WIN32
 
+// civil-edit-start
+#if !USE_OS_TZDB
+#  include <cstring>
+#  ifndef _WIN32
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#  endif  // !_WIN32
+#endif  // !USE_OS_TZDB
+// civil-edit-stop
+
 
 #if HAS_REMOTE_API
    // Note curl includes windows.h so we must include curl AFTER definitions of things
@@ -2076,7 +2091,15 @@ time_zone::init_impl()
 #endif  // defined(NDEBUG)
         load_counts(inf, tzh_ttisgmtcnt, tzh_ttisstdcnt, tzh_leapcnt,
                          tzh_timecnt,    tzh_typecnt,    tzh_charcnt);
+        // civil-edit-start
+        // `load_data()` only reads the leap seconds for the first zone, so
+        // seek past the data block from its start rather than its end
+        const auto data = inf.tellg();
         load_data<int64_t>(inf, tzh_leapcnt, tzh_timecnt, tzh_typecnt, tzh_charcnt);
+        inf.seekg(data + std::streamoff{(8+1)*tzh_timecnt + 6*tzh_typecnt + tzh_charcnt +
+                                        12*tzh_leapcnt + tzh_ttisstdcnt + tzh_ttisgmtcnt});
+        load_footer(inf);
+        // civil-edit-stop
     }
 #if !MISSING_LEAP_SECONDS
     if (tzh_leapcnt > 0)
@@ -2118,6 +2141,30 @@ time_zone::init_impl()
     }
 }
 
+// civil-edit-start
+// The footer is a POSIX TZ string between two newlines, and may be empty.
+// One that can't be parsed is ignored, leaving the last transition's
+// interval open ended as before.
+void
+time_zone::load_footer(std::istream& inf)
+{
+    inf.exceptions(std::ios::goodbit);
+    if (inf.get() != '\n')
+        return;
+    std::string footer;
+    std::getline(inf, footer);
+    if (inf.fail() || footer.empty())
+        return;
+    try
+    {
+        posix_ = std::make_shared<const Posix::time_zone>(footer);
+    }
+    catch (const std::exception&)
+    {
+    }
+}
+// civil-edit-stop
+
 void
 time_zone::init() const
 {
@@ -2156,6 +2203,15 @@ time_zone::get_info_impl(sys_seconds tp) const
 {
     using namespace std;
     init();
+    // civil-edit-start
+    if (posix_ != nullptr && tp >= transitions_.back().timepoint)
+    {
+        auto r = posix_->get_info(tp);
+        if (r.begin < transitions_.back().timepoint)
+            r.begin = transitions_.back().timepoint;
+        return r;
+    }
+    // civil-edit-stop
     return load_sys_info(upper_bound(transitions_.begin(), transitions_.end(), tp,
                                      [](const sys_seconds& x, const transition& t)
                                      {
@@ -2168,6 +2224,17 @@ time_zone::get_info_impl(local_seconds tp) const
 {
     using namespace std::chrono;
     init();
+    // civil-edit-start
+    // A day clear of the last transition, no offset can reach back across it
+    if (posix_ != nullptr &&
+        sys_seconds{tp.time_since_epoch()} - days{1} >= transitions_.back().timepoint)
+    {
+        auto i = posix_->get_info(tp);
+        if (i.first.begin < transitions_.back().timepoint)
+            i.first.begin = transitions_.back().timepoint;
+        return i;
+    }
+    // civil-edit-stop
     local_info i;
     i.result = local_info::unique;
     auto tr = upper_bound(transitions_.begin(), transitions_.end(), tp,
@@ -2255,6 +2322,304 @@ time_zone::time_zone(const std::string& s, detail::undocumented)
     }
 }
 
+// civil-edit-start
+time_zone::time_zone(std::string name, std::shared_ptr<const detail::tzdb_index> index,
+                     std::uint32_t offset)
+    : name_(std::move(name))
+    , index_(std::move(index))
+    , offset_(offset)
+    , adjusted_(new std::once_flag{})
+{
+}
+
+// The years, inclusive, whose transitions are expanded into the flat table
+CONSTDATA auto expanded_first = date::year{1900};
+CONSTDATA auto expanded_last = date::year{2100};
+
+void
+time_zone::expand_infos()
+{
+    using namespace date;
+    using namespace std::chrono;
+    const sys_seconds begin = sys_days{expanded_first/jan/1};
+    const sys_seconds end = sys_days{expanded_last/dec/31} + days{1};
+    sys_seconds tp = begin;
+    while (tp < end)
+    {
+        sys_info r = get_rule_info(tp, static_cast<int>(tz::utc));
+        if (r.end <= tp)
+            break;
+        auto a = std::find(abbrevs_.begin(), abbrevs_.end(), r.abbrev);
+        if (a == abbrevs_.end())
+            a = abbrevs_.insert(a, r.abbrev);
+        expanded_.push_back({r.begin,
+                             static_cast<std::int32_t>(r.offset.count()),
+                             static_cast<std::int32_t>(r.save.count()),
+                             static_cast<std::uint32_t>(a - abbrevs_.begin())});
+        tp = r.end;
+    }
+    if (expanded_.empty())
+        return;
+    expanded_.push_back({tp, 0, 0, 0});
+    expanded_.shrink_to_fit();
+    expanded_begin_ = begin;
+    expanded_end_ = std::min(tp, end);
+    expand_local_infos();
+
+    const std::size_t n = expanded_.size() - 1;
+    while ((std::size_t{1} << eytzinger_depth_) - 1 < n)
+        ++eytzinger_depth_;
+    const std::size_t m = std::size_t{1} << eytzinger_depth_;
+    eytzinger_begins_.assign(m, std::numeric_limits<std::int64_t>::max());
+    eytzinger_offsets_.assign(m, 0);
+    std::size_t k = 0;
+    expand_eytzinger(1, k);
+}
+
+// Fills the subtree at node `i` in order, from entry `k` of the table on.
+// Nodes past the end of the table keep a begin that no instant reaches.
+void
+time_zone::expand_eytzinger(std::size_t i, std::size_t& k)
+{
+    if (i >= eytzinger_begins_.size())
+        return;
+    expand_eytzinger(2 * i, k);
+    if (k < expanded_.size() - 1)
+    {
+        eytzinger_begins_[i] = expanded_[k].begin_.time_since_epoch().count();
+        eytzinger_offsets_[i] = expanded_[k].offset_;
+        ++k;
+    }
+    expand_eytzinger(2 * i + 1, k);
+}
+
+void
+time_zone::get_offsets(const sys_seconds* tps, std::size_t size,
+                       std::chrono::seconds* offsets) const
+{
+    using namespace std::chrono;
+    std::call_once(*adjusted_,
+                   [this]()
+                   {
+                       const_cast<time_zone*>(this)->load_infos();
+                   });
+
+    // Searches run in lock step over a batch, so the loads of one can
+    // overlap with the compares of the others
+    const std::size_t batch = 8;
+    const std::int64_t* begins = eytzinger_begins_.data();
+    const unsigned depth = eytzinger_depth_;
+
+    std::size_t i = 0;
+    while (i < size)
+    {
+        std::size_t n = 0;
+        std::size_t idx[batch];
+        std::int64_t x[batch];
+        std::size_t node[batch];
+        std::size_t found[batch];
+
+        // Gather the next batch of instants in the window
+        for (; i < size && n < batch; ++i)
+        {
+            const sys_seconds tp = tps[i];
+            if (expanded_begin_ <= tp && tp < expanded_end_)
+            {
+                idx[n] = i;
+                x[n] = tp.time_since_epoch().count();
+                node[n] = 1;
+                found[n] = 0;
+                ++n;
+            }
+            else
+            {
+                offsets[i] = get_info(tp).offset;
+            }
+        }
+
+        // The last node whose begin is at or before `x` holds its offset
+        for (unsigned d = 0; d < depth; ++d)
+        {
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                // Masks rather than a conditional, which compilers are
+                // happy to turn back into an unpredictable branch
+                const std::size_t right = begins[node[j]] <= x[j];
+                const std::size_t mask = std::size_t{0} - right;
+                found[j] = (node[j] & mask) | (found[j] & ~mask);
+                node[j] = 2 * node[j] + right;
+            }
+        }
+
+        for (std::size_t j = 0; j < n; ++j)
+            offsets[idx[j]] = seconds{eytzinger_offsets_[found[j]]};
+    }
+}
+
+static std::atomic<bool> local_index_enabled{true};
+
+void
+set_local_index(bool enabled)
+{
+    local_index_enabled = enabled;
+}
+
+// Entry `k` of the table is unique in local time from its begin plus the
+// larger of its offset and the previous entry's offset. Its change to entry
+// `k + 1` then opens a gap or an overlap at its end plus the smaller of the
+// two offsets, unless the offsets are equal.
+void
+time_zone::expand_local_infos()
+{
+    using namespace std::chrono;
+    const std::size_t n = expanded_.size() - 1;
+    expanded_local_.reserve(2 * n);
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        const seconds offset{expanded_[k].offset_};
+        seconds unique = offset;
+        if (k > 0)
+            unique = std::max(unique, seconds{expanded_[k - 1].offset_});
+        expanded_local_.push_back({local_seconds{(expanded_[k].begin_ + unique).time_since_epoch()},
+                                   static_cast<std::uint32_t>(k),
+                                   local_info::unique});
+        if (k + 1 == n)
+            break;
+        const seconds next{expanded_[k + 1].offset_};
+        if (next == offset)
+            continue;
+        const seconds change = std::min(offset, next);
+        expanded_local_.push_back({local_seconds{(expanded_[k + 1].begin_ + change).time_since_epoch()},
+                                   static_cast<std::uint32_t>(k),
+                                   next > offset ? local_info::nonexistent :
+                                                   local_info::ambiguous});
+    }
+    // Transitions closer together than their change in offset can't be
+    // described this way. Fall back to searching the table itself.
+    for (std::size_t i = 1; i < expanded_local_.size(); ++i)
+    {
+        if (expanded_local_[i].begin_ <= expanded_local_[i - 1].begin_)
+        {
+            expanded_local_.clear();
+            break;
+        }
+    }
+    expanded_local_.shrink_to_fit();
+}
+
+const std::uint32_t time_zone::no_abbrev;
+
+sys_info
+time_zone::get_info(sys_seconds tp, std::uint32_t& abbrev_id) const
+{
+    std::call_once(*adjusted_,
+                   [this]()
+                   {
+                       const_cast<time_zone*>(this)->load_infos();
+                   });
+    if (expanded_begin_ <= tp && tp < expanded_end_)
+    {
+        const std::size_t i = get_expanded_index(tp);
+        abbrev_id = expanded_[i].abbrev_;
+        return get_expanded_info(i, false);
+    }
+    abbrev_id = no_abbrev;
+    return get_info_impl(tp);
+}
+
+const std::string&
+time_zone::abbrev(std::uint32_t id) const
+{
+    return abbrevs_[id];
+}
+
+// The entry holding `tp`, which the caller guarantees is in the window
+std::size_t
+time_zone::get_expanded_index(sys_seconds tp) const
+{
+    auto e = std::upper_bound(expanded_.begin(), expanded_.end(), tp,
+        [](sys_seconds t, const expanded_info& x)
+        {
+            return t < x.begin_;
+        });
+    return static_cast<std::size_t>(e - expanded_.begin()) - 1;
+}
+
+sys_info
+time_zone::get_expanded_info(std::size_t i, bool with_abbrev) const
+{
+    using namespace std::chrono;
+    const expanded_info& x = expanded_[i];
+    sys_info r;
+    r.begin = x.begin_;
+    r.end = expanded_[i + 1].begin_;
+    r.offset = seconds{x.offset_};
+    r.save = minutes{x.save_};
+    if (with_abbrev)
+        r.abbrev = abbrevs_[x.abbrev_];
+    return r;
+}
+
+// Mirrors the lookup over the OS database's transitions. The caller
+// guarantees `tp` is at least a day inside the table on both sides.
+local_info
+time_zone::get_expanded_info(local_seconds tp) const
+{
+    using namespace std::chrono;
+    if (!expanded_local_.empty() && local_index_enabled.load(std::memory_order_relaxed))
+    {
+        auto tr = std::upper_bound(expanded_local_.begin(), expanded_local_.end(), tp,
+            [](const local_seconds& x, const expanded_local_info& e)
+            {
+                return x < e.begin_;
+            });
+        const expanded_local_info& e = tr[-1];
+        local_info i{};
+        i.result = static_cast<decltype(i.result)>(e.result_);
+        i.first = get_expanded_info(e.index_);
+        if (e.result_ != local_info::unique)
+            i.second = get_expanded_info(e.index_ + 1);
+        return i;
+    }
+    const auto last = expanded_.end() - 1;
+    auto tr = std::upper_bound(expanded_.begin(), last, tp,
+        [](const local_seconds& x, const expanded_info& e)
+        {
+            return sys_seconds{x.time_since_epoch()} - seconds{e.offset_} < e.begin_;
+        });
+    const auto k = static_cast<std::size_t>(tr - expanded_.begin()) - 1;
+
+    local_info i{};
+    i.result = local_info::unique;
+    i.first = get_expanded_info(k);
+    auto tps = sys_seconds{(tp - i.first.offset).time_since_epoch()};
+    if (tps < i.first.begin + days{1} && k != 0)
+    {
+        i.second = get_expanded_info(k - 1);
+        tps = sys_seconds{(tp - i.second.offset).time_since_epoch()};
+        if (tps < i.second.end)
+        {
+           i.result = local_info::ambiguous;
+           std::swap(i.first, i.second);
+        }
+        else
+        {
+            i.second = {};
+        }
+    }
+    else if (tps >= i.first.end && tr != last)
+    {
+        i.second = get_expanded_info(k + 1);
+        tps = sys_seconds{(tp - i.second.offset).time_since_epoch()};
+        if (tps < i.second.begin)
+            i.result = local_info::nonexistent;
+        else
+            i.second = {};
+    }
+    return i;
+}
+// civil-edit-stop
+
 sys_info
 time_zone::get_info_impl(sys_seconds tp) const
 {
@@ -2265,6 +2630,18 @@ local_info
 time_zone::get_info_impl(local_seconds tp) const
 {
     using namespace std::chrono;
+    // civil-edit-start
+    std::call_once(*adjusted_,
+                   [this]()
+                   {
+                       const_cast<time_zone*>(this)->load_infos();
+                   });
+    // Keep a day's margin so that both neighbours of the interval holding
+    // `tp` are in the table
+    const auto tps_ = sys_seconds{tp.time_since_epoch()};
+    if (expanded_begin_ + days{2} <= tps_ && tps_ + days{2} < expanded_end_)
+        return get_expanded_info(tp);
+    // civil-edit-stop
     local_info i{};
     i.first = get_info_impl(sys_seconds{tp.time_since_epoch()}, static_cast<int>(tz::local));
     auto tps = sys_seconds{(tp - i.first.offset).time_since_epoch()};
@@ -2528,8 +2905,25 @@ time_zone::get_info_impl(sys_seconds tp, int tz_int) const
     std::call_once(*adjusted_,
                    [this]()
                    {
-                       const_cast<time_zone*>(this)->adjust_infos(get_tzdb().rules);
+                       // civil-edit-start
+                       const_cast<time_zone*>(this)->load_infos();
+                       // civil-edit-stop
                    });
+    // civil-edit-start
+    if (timezone == tz::utc && expanded_begin_ <= tp && tp < expanded_end_)
+        return get_expanded_info(get_expanded_index(tp));
+    return get_rule_info(tp, tz_int);
+}
+
+// The rule engine behind `get_info_impl()`, which must have loaded the zone
+sys_info
+time_zone::get_rule_info(sys_seconds tp, int tz_int) const
+{
+    using namespace std::chrono;
+    using namespace date;
+    tz timezone = static_cast<tz>(tz_int);
+    auto y = year_month_day(floor<days>(tp)).year();
+    // civil-edit-stop
     auto i = std::upper_bound(zonelets_.begin(), zonelets_.end(), tp,
         [timezone](sys_seconds t, const zonelet& zl)
         {
@@ -2587,7 +2981,9 @@ operator<<(std::ostream& os, const time_zone& z)
     std::call_once(*z.adjusted_,
                    [&z]()
                    {
-                       const_cast<time_zone&>(z).adjust_infos(get_tzdb().rules);
+                       // civil-edit-start
+                       const_cast<time_zone&>(z).load_infos();
+                       // civil-edit-stop
                    });
     os.width(35);
     os << z.name_;
@@ -3442,65 +3838,606 @@ get_version(const std::string& path)
     throw std::runtime_error("Unable to get Timezone database version from " + path);
 }
 
-static
-std::unique_ptr<tzdb>
-init_tzdb()
+// civil-edit-start
+
+// Binary tzdb cache
+//
+// `write_tzdb_cache()` serializes the parsed text database so that later
+// sessions can skip the text parser entirely. The file is memory mapped and
+// only its directory is decoded up front: zones are created by name, and
+// their zonelets and rules are read on first use (see
+// `time_zone::load_infos()`). It is laid out as:
+//
+//   header:    magic, format version, tzdata version
+//   directory: rule groups (name, offset, count), zones (name, offset),
+//              links (name, target), leap seconds
+//   data:      rule records and zonelet blocks, addressed by the directory
+//              offsets relative to the start of the data section
+//
+// Integers are little endian and strings are length prefixed. The cache is
+// only used when its format and tzdata versions match the text database it
+// sits next to, so a stale or damaged file falls back to the text parser.
+
+static CONSTDATA char tzdb_cache_magic[] = "CIVILTZB";
+static CONSTDATA std::uint32_t tzdb_cache_format = 1;
+static CONSTDATA char tzdb_cache_file[] = "tzdb.bin";
+
+namespace detail
 {
-    using namespace date;
-    const std::string install = get_install();
-    const std::string path = install + folder_delimiter;
-    std::string line;
-    bool continue_zone = false;
-    std::unique_ptr<tzdb> db(new tzdb);
 
-#if AUTO_DOWNLOAD
-    if (!file_exists(install))
+class mapped_file
+{
+    const unsigned char* data_ = nullptr;
+    std::size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+
+public:
+    explicit mapped_file(const std::string& path);
+    ~mapped_file();
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    const unsigned char* data() const {return data_;}
+    std::size_t size() const {return size_;}
+};
+
+#ifdef _WIN32
+
+mapped_file::mapped_file(const std::string& path)
+{
+    file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE)
+        return;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file_, &size) || size.QuadPart == 0)
+        return;
+    mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_ == nullptr)
+        return;
+    void* p = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+    if (p == nullptr)
+        return;
+    data_ = static_cast<const unsigned char*>(p);
+    size_ = static_cast<std::size_t>(size.QuadPart);
+}
+
+mapped_file::~mapped_file()
+{
+    if (data_ != nullptr)
+        UnmapViewOfFile(data_);
+    if (mapping_ != nullptr)
+        CloseHandle(mapping_);
+    if (file_ != INVALID_HANDLE_VALUE)
+        CloseHandle(file_);
+}
+
+#else  // !_WIN32
+
+mapped_file::mapped_file(const std::string& path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        return;
+    struct stat sb;
+    if (::fstat(fd, &sb) == 0 && sb.st_size > 0)
     {
-        auto rv = remote_version();
-        if (!rv.empty() && remote_download(rv))
+        void* p = ::mmap(nullptr, static_cast<std::size_t>(sb.st_size), PROT_READ,
+                         MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED)
         {
-            if (!remote_install(rv))
+            data_ = static_cast<const unsigned char*>(p);
+            size_ = static_cast<std::size_t>(sb.st_size);
+        }
+    }
+    ::close(fd);
+}
+
+mapped_file::~mapped_file()
+{
+    if (data_ != nullptr)
+        ::munmap(const_cast<unsigned char*>(data_), size_);
+}
+
+#endif  // !_WIN32
+
+// Shared by every zone indexed from one cache file, keeping it mapped until
+// the last of them has been loaded
+struct tzdb_index
+{
+    struct rule_group
+    {
+        std::string name;
+        std::uint32_t offset;
+        std::uint32_t count;
+    };
+
+    mapped_file file;
+    const unsigned char* base = nullptr;
+    const unsigned char* end = nullptr;
+    std::vector<rule_group> groups;  // sorted by name
+
+    explicit tzdb_index(const std::string& path) : file(path) {}
+};
+
+struct tzdb_cache
+{
+    class writer
+    {
+        std::string buf_;
+
+    public:
+        void u8(unsigned v) {buf_.push_back(static_cast<char>(v & 0xFF));}
+        void u32(std::uint32_t v)
+        {
+            for (int k = 0; k < 4; ++k, v >>= 8)
+                u8(v);
+        }
+        void i32(std::int32_t v) {u32(static_cast<std::uint32_t>(v));}
+        void i64(std::int64_t v)
+        {
+            auto u = static_cast<std::uint64_t>(v);
+            for (int k = 0; k < 8; ++k, u >>= 8)
+                u8(static_cast<unsigned>(u));
+        }
+        void str(const std::string& x)
+        {
+            u32(static_cast<std::uint32_t>(x.size()));
+            buf_ += x;
+        }
+        void raw(const std::string& x) {buf_ += x;}
+
+        std::size_t size() const {return buf_.size();}
+        std::string& buffer() {return buf_;}
+    };
+
+    // Every read is bounds checked. Running off the end latches `ok()` to
+    // false and yields zeros, so callers only need to check once at the end.
+    class reader
+    {
+        const unsigned char* p_;
+        const unsigned char* end_;
+        bool ok_ = true;
+
+        bool take(std::size_t n)
+        {
+            if (!ok_ || static_cast<std::size_t>(end_ - p_) < n)
             {
-                std::string msg = "Timezone database version \"";
-                msg += rv;
-                msg += "\" did not install correctly to \"";
-                msg += install;
-                msg += "\"";
-                throw std::runtime_error(msg);
+                ok_ = false;
+                return false;
             }
+            return true;
         }
-        if (!file_exists(install))
+
+    public:
+        reader(const unsigned char* p, const unsigned char* end) : p_(p), end_(end) {}
+
+        bool ok() const {return ok_;}
+        void fail() {ok_ = false;}
+        const unsigned char* position() const {return p_;}
+
+        unsigned u8()
         {
-            std::string msg = "Timezone database not found at \"";
-            msg += install;
-            msg += "\"";
-            throw std::runtime_error(msg);
+            if (!take(1))
+                return 0;
+            return *p_++;
         }
-        db->version = get_version(path);
-    }
-    else
-    {
-        db->version = get_version(path);
-        auto rv = remote_version();
-        if (!rv.empty() && db->version != rv)
+        std::uint32_t u32()
         {
-            if (remote_download(rv))
+            if (!take(4))
+                return 0;
+            std::uint32_t v = 0;
+            for (int k = 0; k < 4; ++k)
+                v |= static_cast<std::uint32_t>(*p_++) << (8 * k);
+            return v;
+        }
+        std::int32_t i32() {return static_cast<std::int32_t>(u32());}
+        // The number of items that follow, each at least `size` bytes long. A
+        // count they can't all fit in the bytes left is treated as damage, so
+        // it is never used to reserve memory.
+        std::uint32_t count(std::size_t size)
+        {
+            const std::uint32_t n = u32();
+            if (!ok_ || static_cast<std::size_t>(end_ - p_) / size < n)
             {
-                remote_install(rv);
-                db->version = get_version(path);
+                ok_ = false;
+                return 0;
             }
+            return n;
         }
+        std::int64_t i64()
+        {
+            if (!take(8))
+                return 0;
+            std::uint64_t v = 0;
+            for (int k = 0; k < 8; ++k)
+                v |= static_cast<std::uint64_t>(*p_++) << (8 * k);
+            return static_cast<std::int64_t>(v);
+        }
+        std::string str()
+        {
+            const std::uint32_t n = u32();
+            if (!take(n))
+                return std::string();
+            std::string x(reinterpret_cast<const char*>(p_), n);
+            p_ += n;
+            return x;
+        }
+        bool magic(const char* x, std::size_t n)
+        {
+            if (!take(n) || std::memcmp(p_, x, n) != 0)
+                return ok_ = false;
+            p_ += n;
+            return true;
+        }
+    };
+
+    static void write_mdt(writer& out, const MonthDayTime& x);
+    static void read_mdt(reader& in, MonthDayTime& x);
+
+    static void write_rule(writer& out, const Rule& x);
+    static void read_rule(reader& in, Rule& x);
+
+    static void write_zonelets(writer& out, const time_zone& x);
+    static void read_zonelets(reader& in, time_zone& x);
+
+    // The fewest bytes each item of a count can take, see `reader::count()`
+    static const std::size_t mdt_size = 5 + 3*4;
+    static const std::size_t zonelet_size = 8 + 4 + 4 + 4 + mdt_size;
+    static const std::size_t group_size = 4 + 4 + 4;
+    static const std::size_t zone_size = 4 + 4;
+    static const std::size_t link_size = 4 + 4;
+    static const std::size_t leap_size = 8;
+
+    static std::string write(const tzdb& db);
+    static bool load(const std::string& file, tzdb* db);
+    static void read_zone(time_zone& z);
+};
+
+void
+tzdb_cache::write_mdt(writer& out, const MonthDayTime& x)
+{
+    out.u8(static_cast<unsigned>(x.type_));
+    out.u8(static_cast<unsigned>(x.zone_));
+    switch (x.type_)
+    {
+    case MonthDayTime::month_day:
+        out.u8(static_cast<unsigned>(x.u.month_day_.month()));
+        out.u8(static_cast<unsigned>(x.u.month_day_.day()));
+        out.u8(0);
+        break;
+    case MonthDayTime::month_last_dow:
+        out.u8(static_cast<unsigned>(x.u.month_weekday_last_.month()));
+        out.u8(0);
+        out.u8(x.u.month_weekday_last_.weekday_last().weekday().c_encoding());
+        break;
+    case MonthDayTime::lteq:
+    case MonthDayTime::gteq:
+        out.u8(static_cast<unsigned>(x.u.month_day_weekday_.month_day_.month()));
+        out.u8(static_cast<unsigned>(x.u.month_day_weekday_.month_day_.day()));
+        out.u8(x.u.month_day_weekday_.weekday_.c_encoding());
+        break;
     }
-#else  // !AUTO_DOWNLOAD
-    if (!file_exists(install))
+    out.i32(static_cast<std::int32_t>(x.h_.count()));
+    out.i32(static_cast<std::int32_t>(x.m_.count()));
+    out.i32(static_cast<std::int32_t>(x.s_.count()));
+}
+
+void
+tzdb_cache::read_mdt(reader& in, MonthDayTime& x)
+{
+    using namespace date;
+    const unsigned type = in.u8();
+    const unsigned zone = in.u8();
+    const date::month m(in.u8());
+    const date::day d(in.u8());
+    const date::weekday wd(in.u8());
+    if (type > MonthDayTime::gteq || zone > static_cast<unsigned>(tz::standard))
     {
-        std::string msg = "Timezone database not found at \"";
-        msg += install;
-        msg += "\"";
-        throw std::runtime_error(msg);
+        in.fail();
+        return;
     }
-    db->version = get_version(path);
-#endif  // !AUTO_DOWNLOAD
+    x.type_ = static_cast<MonthDayTime::Type>(type);
+    x.zone_ = static_cast<tz>(zone);
+    switch (x.type_)
+    {
+    case MonthDayTime::month_day:
+        x.u = m/d;
+        break;
+    case MonthDayTime::month_last_dow:
+        x.u = m/wd[last];
+        break;
+    case MonthDayTime::lteq:
+    case MonthDayTime::gteq:
+        x.u = MonthDayTime::pair{m/d, wd};
+        break;
+    }
+    x.h_ = std::chrono::hours{in.i32()};
+    x.m_ = std::chrono::minutes{in.i32()};
+    x.s_ = std::chrono::seconds{in.i32()};
+}
+
+void
+tzdb_cache::write_rule(writer& out, const Rule& x)
+{
+    out.i32(static_cast<int>(x.starting_year_));
+    out.i32(static_cast<int>(x.ending_year_));
+    write_mdt(out, x.starting_at_);
+    out.i32(static_cast<std::int32_t>(x.save_.count()));
+    out.str(x.abbrev_);
+}
+
+void
+tzdb_cache::read_rule(reader& in, Rule& x)
+{
+    x.starting_year_ = date::year{in.i32()};
+    x.ending_year_ = date::year{in.i32()};
+    read_mdt(in, x.starting_at_);
+    x.save_ = std::chrono::minutes{in.i32()};
+    x.abbrev_ = in.str();
+}
+
+// Zonelets are stored as parsed, before `adjust_infos()` fills in the
+// computed fields on first use
+void
+tzdb_cache::write_zonelets(writer& out, const time_zone& x)
+{
+    out.u32(static_cast<std::uint32_t>(x.zonelets_.size()));
+    for (const auto& z : x.zonelets_)
+    {
+        out.i64(z.gmtoff_.count());
+        out.str(z.u.rule_);
+        out.str(z.format_);
+        out.i32(static_cast<int>(z.until_year_));
+        write_mdt(out, z.until_date_);
+    }
+}
+
+void
+tzdb_cache::read_zonelets(reader& in, time_zone& x)
+{
+    const std::uint32_t n = in.count(zonelet_size);
+    x.zonelets_.reserve(n);
+    for (std::uint32_t i = 0; i < n && in.ok(); ++i)
+    {
+        x.zonelets_.emplace_back();
+        auto& z = x.zonelets_.back();
+        z.gmtoff_ = std::chrono::seconds{in.i64()};
+        z.u.rule_ = in.str();
+        z.format_ = in.str();
+        z.until_year_ = date::year{in.i32()};
+        read_mdt(in, z.until_date_);
+    }
+}
+
+std::string
+tzdb_cache::write(const tzdb& db)
+{
+    writer data;
+    writer dir;
+
+    // `db.rules` is sorted by name, so each rule set is a contiguous group
+    std::size_t n_groups = 0;
+    for (std::size_t i = 0; i < db.rules.size(); ++n_groups)
+    {
+        std::size_t j = i;
+        while (j < db.rules.size() && db.rules[j].name_ == db.rules[i].name_)
+            ++j;
+        i = j;
+    }
+    dir.u32(static_cast<std::uint32_t>(n_groups));
+    for (std::size_t i = 0; i < db.rules.size();)
+    {
+        std::size_t j = i;
+        const std::uint32_t offset = static_cast<std::uint32_t>(data.size());
+        while (j < db.rules.size() && db.rules[j].name_ == db.rules[i].name_)
+            write_rule(data, db.rules[j++]);
+        dir.str(db.rules[i].name_);
+        dir.u32(offset);
+        dir.u32(static_cast<std::uint32_t>(j - i));
+        i = j;
+    }
+
+    dir.u32(static_cast<std::uint32_t>(db.zones.size()));
+    for (const auto& z : db.zones)
+    {
+        dir.str(z.name_);
+        dir.u32(static_cast<std::uint32_t>(data.size()));
+        write_zonelets(data, z);
+    }
+
+    dir.u32(static_cast<std::uint32_t>(db.links.size()));
+    for (const auto& l : db.links)
+    {
+        dir.str(l.name_);
+        dir.str(l.target_);
+    }
+
+    dir.u32(static_cast<std::uint32_t>(db.leap_seconds.size()));
+    for (const auto& l : db.leap_seconds)
+        dir.i64(l.date_.time_since_epoch().count());
+
+    writer out;
+    out.raw(std::string(tzdb_cache_magic, sizeof(tzdb_cache_magic) - 1));
+    out.u32(tzdb_cache_format);
+    out.str(db.version);
+    out.u32(static_cast<std::uint32_t>(dir.size()));
+    out.raw(dir.buffer());
+    out.raw(data.buffer());
+    return std::move(out.buffer());
+}
+
+// Indexes the cache at `file` into `db`, returning `false` and leaving `db`
+// untouched if the file is missing, damaged, or not built from `db->version`
+bool
+tzdb_cache::load(const std::string& file, tzdb* db)
+{
+    std::shared_ptr<tzdb_index> index = std::make_shared<tzdb_index>(file);
+    if (index->file.data() == nullptr)
+        return false;
+
+    const unsigned char* end = index->file.data() + index->file.size();
+    reader in(index->file.data(), end);
+
+    if (!in.magic(tzdb_cache_magic, sizeof(tzdb_cache_magic) - 1))
+        return false;
+    if (in.u32() != tzdb_cache_format)
+        return false;
+    if (in.str() != db->version || !in.ok())
+        return false;
+
+    const std::uint32_t dir_size = in.u32();
+    if (!in.ok() || static_cast<std::size_t>(end - in.position()) < dir_size)
+        return false;
+    const unsigned char* base = in.position() + dir_size;
+    const std::size_t data_size = static_cast<std::size_t>(end - base);
+    index->base = base;
+    index->end = end;
+
+    const std::uint32_t n_groups = in.count(group_size);
+    if (!in.ok())
+        return false;
+    index->groups.reserve(n_groups);
+    for (std::uint32_t i = 0; i < n_groups && in.ok(); ++i)
+    {
+        tzdb_index::rule_group group;
+        group.name = in.str();
+        group.offset = in.u32();
+        group.count = in.u32();
+        if (group.offset > data_size)
+            return false;
+        index->groups.push_back(std::move(group));
+    }
+
+    std::vector<time_zone> zones;
+    const std::uint32_t n_zones = in.count(zone_size);
+    if (!in.ok())
+        return false;
+    zones.reserve(n_zones);
+    for (std::uint32_t i = 0; i < n_zones && in.ok(); ++i)
+    {
+        std::string name = in.str();
+        const std::uint32_t offset = in.u32();
+        if (offset > data_size)
+            return false;
+        zones.push_back(time_zone(std::move(name), index, offset));
+    }
+
+    std::vector<time_zone_link> links;
+    const std::uint32_t n_links = in.count(link_size);
+    if (!in.ok())
+        return false;
+    links.reserve(n_links);
+    for (std::uint32_t i = 0; i < n_links && in.ok(); ++i)
+    {
+        links.push_back(time_zone_link());
+        links.back().name_ = in.str();
+        links.back().target_ = in.str();
+    }
+
+    std::vector<leap_second> leap_seconds;
+    const std::uint32_t n_leaps = in.count(leap_size);
+    if (!in.ok())
+        return false;
+    leap_seconds.reserve(n_leaps);
+    for (std::uint32_t i = 0; i < n_leaps && in.ok(); ++i)
+    {
+        leap_seconds.push_back(leap_second());
+        leap_seconds.back().date_ = sys_seconds{std::chrono::seconds{in.i64()}};
+    }
+
+    if (!in.ok() || in.position() != base)
+        return false;
+
+    db->rules.clear();
+    db->zones = std::move(zones);
+    db->links = std::move(links);
+    db->leap_seconds = std::move(leap_seconds);
+    return true;
+}
+
+// Reads the zonelets of `z`, and copies of the rules they refer to, from the
+// cache it was indexed from. `z.rules_` ends up sorted by name, as
+// `adjust_infos()` requires.
+void
+tzdb_cache::read_zone(time_zone& z)
+{
+    const tzdb_index& index = *z.index_;
+    z.zonelets_.clear();
+    z.rules_.clear();
+
+    reader in(index.base + z.offset_, index.end);
+    read_zonelets(in, z);
+    bool ok = in.ok();
+
+    std::vector<std::string> names;
+    for (const auto& zl : z.zonelets_)
+        names.push_back(zl.u.rule_);
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+
+    for (const auto& name : names)
+    {
+        auto group = std::lower_bound(index.groups.begin(), index.groups.end(), name,
+            [](const tzdb_index::rule_group& x, const std::string& y)
+            {
+                return x.name < y;
+            });
+        // Not a rule set name, but a fixed save or empty
+        if (group == index.groups.end() || group->name != name)
+            continue;
+        reader rules(index.base + group->offset, index.end);
+        for (std::uint32_t k = 0; k < group->count && rules.ok(); ++k)
+        {
+            z.rules_.emplace_back();
+            z.rules_.back().name_ = name;
+            read_rule(rules, z.rules_.back());
+        }
+        ok = ok && rules.ok();
+    }
+
+    if (!ok)
+    {
+        z.zonelets_.clear();
+        z.rules_.clear();
+        throw std::runtime_error("Time zone database cache is damaged, unable to load " +
+                                 z.name_);
+    }
+}
+
+}  // namespace detail
+
+// Zones parsed from the text files share the database wide rules, zones
+// indexed from the cache load their own on first use
+void
+time_zone::load_infos()
+{
+    if (index_ == nullptr)
+    {
+        adjust_infos(get_tzdb().rules);
+    }
+    else
+    {
+        detail::tzdb_cache::read_zone(*this);
+        index_.reset();
+        adjust_infos(rules_);
+    }
+    expand_infos();
+}
+
+// civil-edit-stop
+
+// civil-edit-start
+static
+void
+parse_tzdb(const std::string& path, tzdb* db)
+{
+    std::string line;
+    bool continue_zone = false;
 
     CONSTDATA char*const files[] =
     {
@@ -3545,9 +4482,7 @@ init_tzdb()
                 }
                 else
                 {
-                    // civil-edit-start
                     // std::cerr << line << '\n';
-                    // civil-edit-stop
                 }
             }
         }
@@ -3560,9 +4495,75 @@ init_tzdb()
     db->links.shrink_to_fit();
     std::sort(db->leap_seconds.begin(), db->leap_seconds.end());
     db->leap_seconds.shrink_to_fit();
+}
+
+static
+std::unique_ptr<tzdb>
+init_tzdb(const std::string& install, bool use_cache)
+{
+    using namespace date;
+    const std::string path = install + folder_delimiter;
+    std::unique_ptr<tzdb> db(new tzdb);
+// civil-edit-stop
+
+#if AUTO_DOWNLOAD
+    if (!file_exists(install))
+    {
+        auto rv = remote_version();
+        if (!rv.empty() && remote_download(rv))
+        {
+            if (!remote_install(rv))
+            {
+                std::string msg = "Timezone database version \"";
+                msg += rv;
+                msg += "\" did not install correctly to \"";
+                msg += install;
+                msg += "\"";
+                throw std::runtime_error(msg);
+            }
+        }
+        if (!file_exists(install))
+        {
+            std::string msg = "Timezone database not found at \"";
+            msg += install;
+            msg += "\"";
+            throw std::runtime_error(msg);
+        }
+        db->version = get_version(path);
+    }
+    else
+    {
+        db->version = get_version(path);
+        auto rv = remote_version();
+        if (!rv.empty() && db->version != rv)
+        {
+            if (remote_download(rv))
+            {
+                remote_install(rv);
+                db->version = get_version(path);
+            }
+        }
+    }
+#else  // !AUTO_DOWNLOAD
+    if (!file_exists(install))
+    {
+        std::string msg = "Timezone database not found at \"";
+        msg += install;
+        msg += "\"";
+        throw std::runtime_error(msg);
+    }
+    db->version = get_version(path);
+#endif  // !AUTO_DOWNLOAD
+
+    // civil-edit-start
+    if (!use_cache || !detail::tzdb_cache::load(path + tzdb_cache_file, db.get()))
+        parse_tzdb(path, db.get());
+    // civil-edit-stop
 
 #ifdef _WIN32
-    std::string mapping_file = get_install() + folder_delimiter + "windowsZones.xml";
+    // civil-edit-start
+    std::string mapping_file = install + folder_delimiter + "windowsZones.xml";
+    // civil-edit-stop
     db->mappings = load_timezone_mappings_from_xml_file(mapping_file);
     sort_zone_mappings(db->mappings);
 #endif // _WIN32
@@ -3570,6 +4571,37 @@ init_tzdb()
     return db;
 }
 
+// civil-edit-start
+static
+std::unique_ptr<tzdb>
+init_tzdb()
+{
+    return init_tzdb(get_install(), true);
+}
+
+void
+write_tzdb_cache(const std::string& install, const std::string& path)
+{
+    const std::string bytes = detail::tzdb_cache::write(*init_tzdb(install, false));
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream outfile(tmp, std::ios::out | std::ios::binary | std::ios::trunc);
+        outfile.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (!outfile)
+            throw std::runtime_error("Unable to write time zone database cache to \"" +
+                                     tmp + "\"");
+    }
+    // Windows refuses to rename over an existing file
+    std::remove(path.c_str());
+    if (std::rename(tmp.c_str(), path.c_str()) != 0)
+    {
+        std::remove(tmp.c_str());
+        throw std::runtime_error("Unable to write time zone database cache to \"" +
+                                 path + "\"");
+    }
+}
+// civil-edit-stop
+
 const tzdb&
 reload_tzdb()
 {
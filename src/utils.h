@@ -2,6 +2,7 @@
 #define CIVIL_UTILS_H
 
 #include "civil.h"
+#include "altrep.h"
 #include <cstdint>
 #include <cmath>
 #include <cstdarg> // For `va_start()` and `va_end()`
@@ -31,6 +32,20 @@ static inline const int* civil_int_deref_const(SEXP x) {
   return cpp11::safe[r_int_deref_const](x);
 }
 
+static inline double* r_dbl_deref(SEXP x) {
+  return REAL(x);
+}
+static inline double* civil_dbl_deref(SEXP x) {
+  return cpp11::safe[r_dbl_deref](x);
+}
+
+static inline const double* r_dbl_deref_const(SEXP x) {
+  return (const double*) REAL(x);
+}
+static inline const double* civil_dbl_deref_const(SEXP x) {
+  return cpp11::safe[r_dbl_deref_const](x);
+}
+
 static inline r_ssize r_length(SEXP x) {
   return Rf_xlength(x);
 }
@@ -113,12 +128,13 @@ static inline void never_reached [[noreturn]] (const char* fn) {
 // -----------------------------------------------------------------------------
 
 /*
- * TODO: How best to write these in C++ to avoid copies when returning?
+ * Recycling a scalar gives a compact repeat rather than allocating the
+ * repeated copies, see `altrep.h`. These return plain `SEXP`s, as wrapping a
+ * compact repeat in a writable cpp11 vector would duplicate it.
  */
 
-static inline cpp11::writable::integers civil_int_recycle(const cpp11::writable::integers& x,
-                                                          const r_ssize& size) {
-  r_ssize x_size = x.size();
+static inline SEXP civil_int_recycle(SEXP x, const r_ssize& size) {
+  r_ssize x_size = civil_length(x);
 
   if (x_size == size) {
     return x;
@@ -127,19 +143,13 @@ static inline cpp11::writable::integers civil_int_recycle(const cpp11::writable:
     civil_abort("`x` must be size 1 or %i.", (int) size);
   }
 
-  int val = x[0];
-  cpp11::writable::integers out(size);
+  int val = civil_int_deref_const(x)[0];
 
-  for (r_ssize i = 0; i < size; ++i) {
-    out[i] = val;
-  }
-
-  return out;
+  return cpp11::safe[civil_compact_rep_int](val, size);
 }
 
-static inline cpp11::strings civil_chr_recycle(const cpp11::strings& x,
-                                               const r_ssize& size) {
-  r_ssize x_size = x.size();
+static inline SEXP civil_chr_recycle(SEXP x, const r_ssize& size) {
+  r_ssize x_size = civil_length(x);
 
   if (x_size == size) {
     return x;
@@ -148,14 +158,9 @@ static inline cpp11::strings civil_chr_recycle(const cpp11::strings& x,
     civil_abort("`x` must be size 1 or %i.", (int) size);
   }
 
-  cpp11::r_string val = x[0];
-  cpp11::writable::strings out(size);
+  SEXP val = STRING_ELT(x, 0);
 
-  for (r_ssize i = 0; i < size; ++i) {
-    out[i] = val;
-  }
-
-  return out;
+  return cpp11::safe[civil_compact_rep_chr](val, size);
 }
 
 static inline cpp11::sexp civil_names_recycle(const cpp11::sexp& names,
@@ -168,9 +173,7 @@ static inline cpp11::sexp civil_names_recycle(const cpp11::sexp& names,
     civil_abort("`names` must be a character vector or `NULL`.");
   }
 
-  cpp11::strings typed_names = cpp11::as_cpp<cpp11::strings>(names);
-
-  return civil_chr_recycle(typed_names, size);
+  return civil_chr_recycle(names, size);
 }
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,186 @@
+#include "ymd.h"
+#include <cstring>
+
+// -----------------------------------------------------------------------------
+
+/*
+ * The block loops have no control flow in their bodies, with missing values
+ * computed like any other and masked out afterwards, so compilers vectorise
+ * them.
+ *
+ * R compiles packages at `-O2` without any SIMD flags beyond the baseline of
+ * the platform, and at `-O2` GCC only vectorises the very cheapest loops. So on
+ * x86 with GCC or clang, each loop is compiled twice through the `target`
+ * attribute, once for the baseline and once for AVX2, and the AVX2 clone is
+ * picked at runtime when the CPU supports it. Elsewhere the baseline loop is
+ * all there is.
+ */
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define YMD_HAS_AVX2_CLONE 1
+#else
+#define YMD_HAS_AVX2_CLONE 0
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__)
+#define YMD_VECTORIZE __attribute__((optimize("tree-loop-vectorize")))
+#else
+#define YMD_VECTORIZE
+#endif
+
+#if defined(__GNUC__)
+#define YMD_ALWAYS_INLINE inline __attribute__((always_inline))
+#define YMD_RESTRICT __restrict__
+#else
+#define YMD_ALWAYS_INLINE inline
+#define YMD_RESTRICT
+#endif
+
+#if YMD_HAS_AVX2_CLONE
+static bool ymd_has_avx2() {
+  static const bool out = __builtin_cpu_supports("avx2");
+  return out;
+}
+#endif
+
+// -----------------------------------------------------------------------------
+
+static YMD_ALWAYS_INLINE void days_to_ymd_loop(const int* YMD_RESTRICT p_days,
+                                               r_ssize size,
+                                               int* YMD_RESTRICT p_year,
+                                               int* YMD_RESTRICT p_month,
+                                               int* YMD_RESTRICT p_day) {
+  for (r_ssize i = 0; i < size; ++i) {
+    const int elt_days = p_days[i];
+    const bool na = elt_days == r_int_na;
+
+    int year;
+    int month;
+    int day;
+
+    days_to_ymd_one(elt_days, year, month, day);
+
+    p_year[i] = na ? r_int_na : year;
+    p_month[i] = na ? r_int_na : month;
+    p_day[i] = na ? r_int_na : day;
+  }
+}
+
+static YMD_VECTORIZE void days_to_ymd_block_default(const int* p_days,
+                                                    r_ssize size,
+                                                    int* p_year,
+                                                    int* p_month,
+                                                    int* p_day) {
+  days_to_ymd_loop(p_days, size, p_year, p_month, p_day);
+}
+
+#if YMD_HAS_AVX2_CLONE
+__attribute__((target("avx2")))
+static YMD_VECTORIZE void days_to_ymd_block_avx2(const int* p_days,
+                                                 r_ssize size,
+                                                 int* p_year,
+                                                 int* p_month,
+                                                 int* p_day) {
+  days_to_ymd_loop(p_days, size, p_year, p_month, p_day);
+}
+#endif
+
+static inline void days_to_ymd_block(const int* p_days,
+                                     r_ssize size,
+                                     int* p_year,
+                                     int* p_month,
+                                     int* p_day) {
+#if YMD_HAS_AVX2_CLONE
+  if (ymd_has_avx2()) {
+    days_to_ymd_block_avx2(p_days, size, p_year, p_month, p_day);
+    return;
+  }
+#endif
+  days_to_ymd_block_default(p_days, size, p_year, p_month, p_day);
+}
+
+// [[ include("ymd.h") ]]
+void days_to_ymd(const int* p_days,
+                 r_ssize size,
+                 int* p_year,
+                 int* p_month,
+                 int* p_day) {
+  if (p_year != NULL && p_month != NULL && p_day != NULL) {
+    days_to_ymd_block(p_days, size, p_year, p_month, p_day);
+    return;
+  }
+
+  int block_year[YMD_BLOCK_SIZE];
+  int block_month[YMD_BLOCK_SIZE];
+  int block_day[YMD_BLOCK_SIZE];
+
+  for (r_ssize start = 0; start < size; start += YMD_BLOCK_SIZE) {
+    const r_ssize n = size - start < YMD_BLOCK_SIZE ? size - start : YMD_BLOCK_SIZE;
+
+    days_to_ymd_block(p_days + start, n, block_year, block_month, block_day);
+
+    if (p_year != NULL) {
+      std::memcpy(p_year + start, block_year, n * sizeof(int));
+    }
+    if (p_month != NULL) {
+      std::memcpy(p_month + start, block_month, n * sizeof(int));
+    }
+    if (p_day != NULL) {
+      std::memcpy(p_day + start, block_day, n * sizeof(int));
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+static YMD_ALWAYS_INLINE void ymd_to_days_loop(const int* YMD_RESTRICT p_year,
+                                               const int* YMD_RESTRICT p_month,
+                                               const int* YMD_RESTRICT p_day,
+                                               r_ssize size,
+                                               int* YMD_RESTRICT p_days) {
+  for (r_ssize i = 0; i < size; ++i) {
+    const int elt_year = p_year[i];
+    const int elt_month = p_month[i];
+    const int elt_day = p_day[i];
+
+    const bool na = elt_year == r_int_na || elt_month == r_int_na || elt_day == r_int_na;
+
+    const int elt_days = ymd_to_days_one(elt_year, elt_month, elt_day);
+
+    p_days[i] = na ? r_int_na : elt_days;
+  }
+}
+
+static YMD_VECTORIZE void ymd_to_days_default(const int* p_year,
+                                              const int* p_month,
+                                              const int* p_day,
+                                              r_ssize size,
+                                              int* p_days) {
+  ymd_to_days_loop(p_year, p_month, p_day, size, p_days);
+}
+
+#if YMD_HAS_AVX2_CLONE
+__attribute__((target("avx2")))
+static YMD_VECTORIZE void ymd_to_days_avx2(const int* p_year,
+                                           const int* p_month,
+                                           const int* p_day,
+                                           r_ssize size,
+                                           int* p_days) {
+  ymd_to_days_loop(p_year, p_month, p_day, size, p_days);
+}
+#endif
+
+// [[ include("ymd.h") ]]
+void ymd_to_days(const int* p_year,
+                 const int* p_month,
+                 const int* p_day,
+                 r_ssize size,
+                 int* p_days) {
+#if YMD_HAS_AVX2_CLONE
+  if (ymd_has_avx2()) {
+    ymd_to_days_avx2(p_year, p_month, p_day, size, p_days);
+    return;
+  }
+#endif
+  ymd_to_days_default(p_year, p_month, p_day, size, p_days);
+}
@@ -0,0 +1,165 @@
+#ifndef CIVIL_YMD_H
+#define CIVIL_YMD_H
+
+#include "civil.h"
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Conversions between days since the epoch and a civil year, month and day.
+ *
+ * These give exactly what `date::year_month_day{local_days}` and
+ * `date::local_days{year_month_day}` give. They are Howard Hinnant's
+ * `civil_from_days()` and `days_from_civil()` algorithms, in the form given by
+ * Neri and Schneider, "Euclidean affine functions and their application to
+ * calendar algorithms" (2022). Shifting the epoch back far enough that every
+ * supported day is positive lets them run on unsigned 32-bit integers, with
+ * most divisions turned into a multiply and a shift, and without branches.
+ *
+ * Inputs must be within the range of `date::year`, which any valid local date
+ * is. Other values, like `NA_integer_`, give garbage. All of the arithmetic is
+ * done on unsigned integers, so even then nothing overflows.
+ */
+
+// The shift moves the epoch back 82 eras of 400 years, to a March 1st
+#define YMD_YEARS_SHIFT 32800
+#define YMD_DAYS_SHIFT 12699422
+
+static inline void days_to_ymd_one(const int& days, int& year, int& month, int& day) {
+  const uint32_t n = static_cast<uint32_t>(days) + YMD_DAYS_SHIFT;
+
+  // Century, and day of the century
+  const uint32_t n_1 = 4 * n + 3;
+  const uint32_t century = n_1 / 146097;
+  const uint32_t n_century = n_1 % 146097 / 4;
+
+  // Year of the century, and day of the year
+  const uint32_t n_2 = 4 * n_century + 3;
+  const uint64_t p_2 = static_cast<uint64_t>(2939745) * n_2;
+  const uint32_t year_of_century = static_cast<uint32_t>(p_2 >> 32);
+  const uint32_t n_year = static_cast<uint32_t>(p_2) / 2939745 / 4;
+
+  // Month and day, in a year that starts in March
+  const uint32_t n_3 = 2141 * n_year + 197913;
+  const uint32_t shifted_month = n_3 >> 16;
+  const uint32_t shifted_day = (n_3 & 0xFFFF) / 2141;
+
+  // January and February belong to the next civil year
+  const uint32_t january_or_february = n_year >= 306;
+
+  year = static_cast<int>(100 * century + year_of_century + january_or_february) - YMD_YEARS_SHIFT;
+  month = static_cast<int>(january_or_february ? shifted_month - 12 : shifted_month);
+  day = static_cast<int>(shifted_day + 1);
+}
+
+static inline int ymd_to_days_one(const int& year, const int& month, const int& day) {
+  const uint32_t january_or_february = month <= 2;
+
+  const uint32_t shifted_year = static_cast<uint32_t>(year) + YMD_YEARS_SHIFT - january_or_february;
+  const uint32_t shifted_month = static_cast<uint32_t>(month) + 12 * january_or_february;
+  const uint32_t shifted_day = static_cast<uint32_t>(day) - 1;
+
+  const uint32_t century = shifted_year / 100;
+  const uint32_t days_before_year = 1461 * shifted_year / 4 - century + century / 4;
+  const uint32_t days_before_month = (979 * shifted_month - 2919) / 32;
+
+  return static_cast<int>(days_before_year + days_before_month + shifted_day - YMD_DAYS_SHIFT);
+}
+
+/*
+ * For the kernels that work with `date::year_month_day` objects
+ */
+static inline date::year_month_day days_to_ymd_one(const int& days) {
+  int year;
+  int month;
+  int day;
+
+  days_to_ymd_one(days, year, month, day);
+
+  return date::year{year} / date::month{static_cast<unsigned int>(month)} / date::day{static_cast<unsigned int>(day)};
+}
+static inline int ymd_to_days_one(const date::year_month_day& ymd) {
+  return ymd_to_days_one(
+    static_cast<int>(ymd.year()),
+    static_cast<int>(static_cast<unsigned int>(ymd.month())),
+    static_cast<int>(static_cast<unsigned int>(ymd.day()))
+  );
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Closed forms for the other calendar components of a day. 1970-01-01 was a
+ * Thursday, so the weekday is a remainder of `days + 3` once it is floored.
+ * Weekdays use the ISO encoding, from Monday as `1` to Sunday as `7`.
+ */
+
+static inline int days_to_iso_weekday_one(const int& days) {
+  const int remainder = (days + 3) % 7;
+  return remainder < 0 ? remainder + 8 : remainder + 1;
+}
+
+static inline int days_to_day_of_year_one(const int& days, const int& year) {
+  return days - ymd_to_days_one(year, 1, 1) + 1;
+}
+
+/*
+ * Whether a day in `[1, 31]` exists in a month in `[1, 12]`. Every month has
+ * at least 28 days, and the 31 day months alternate up to July and from
+ * August on.
+ */
+static inline bool ymd_exists_one(const int& year, const int& month, const int& day) {
+  if (day <= 28) {
+    return true;
+  }
+  if (month != 2) {
+    return day <= 30 + ((month + month / 8) & 1);
+  }
+
+  const bool leap = year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+  return day <= 28 + leap;
+}
+
+/*
+ * An ISO week belongs to the year that its Thursday falls in, and week 1 is
+ * the week with that year's first Thursday
+ */
+static inline void days_to_iso_year_week_one(const int& days, int& iso_year, int& iso_week) {
+  const int thursday = days - days_to_iso_weekday_one(days) + 4;
+
+  int month;
+  int day;
+
+  days_to_ymd_one(thursday, iso_year, month, day);
+
+  iso_week = (days_to_day_of_year_one(thursday, iso_year) - 1) / 7 + 1;
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Block versions, see `ymd.cpp`. Missing days give missing components, and
+ * any of the output pointers can be `NULL` to skip that component. Missing
+ * components give missing days, and the others must already be valid.
+ */
+
+/*
+ * When only some components are wanted, the others are written to blocks of
+ * this many elements on the stack and thrown away, which keeps the loops
+ * themselves free of branches
+ */
+#define YMD_BLOCK_SIZE 512
+
+void days_to_ymd(const int* p_days,
+                 r_ssize size,
+                 int* p_year,
+                 int* p_month,
+                 int* p_day);
+
+void ymd_to_days(const int* p_year,
+                 const int* p_month,
+                 const int* p_day,
+                 r_ssize size,
+                 int* p_days);
+
+#endif
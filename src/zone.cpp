@@ -1,5 +1,9 @@
 #include "zone.h"
 #include "utils.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <unordered_map>
 
 /*
  * Brought over from lubridate/timechange
@@ -49,12 +53,9 @@ cpp11::writable::logicals zone_is_valid(const cpp11::strings& zone) {
     return cpp11::writable::logicals({cpp11::r_bool(true)});
   }
 
-  try {
-    date::locate_zone(zone_name);
-    return cpp11::writable::logicals({cpp11::r_bool(true)});
-  } catch (const std::runtime_error& error) {
-    return cpp11::writable::logicals({cpp11::r_bool(false)});
-  };
+  const bool valid = zone_name_find(zone_name) != NULL;
+
+  return cpp11::writable::logicals({cpp11::r_bool(valid)});
 }
 
 // -----------------------------------------------------------------------------
@@ -67,29 +68,454 @@ cpp11::writable::strings zone_current() {
 // -----------------------------------------------------------------------------
 
 
-const date::time_zone* zone_name_load_try(const std::string& zone_name);
+static bool zone_name_parse_fixed(const std::string& zone_name, civil_zone& zone);
+static bool zone_name_parse_offset(const char* p_name, std::chrono::seconds& offset);
+static std::string zone_offset_abbrev(const std::chrono::seconds& offset);
+
+/*
+ * Kernels load their zone on every call, and in grouped code that can be
+ * hundreds of thousands of calls on small vectors. Successful loads are
+ * remembered here so that repeat calls cost a single hash lookup rather than
+ * two binary searches over the zone and link names in the tzdb. Pointers to
+ * the loaded zones stay valid for the whole session, as entries are never
+ * removed and the tzdb is never reloaded.
+ *
+ * The local time zone, `""`, is remembered separately along with the value of
+ * the `TZ` envvar it was resolved from, and is resolved again whenever `TZ`
+ * changes. Only R's main thread loads zones, so there is no locking.
+ */
+static std::unordered_map<std::string, civil_zone> zone_name_cache;
+
+static bool zone_name_current_cached = false;
+static bool zone_name_current_tz_set = false;
+static std::string zone_name_current_tz;
+static const civil_zone* zone_name_current_p_zone = NULL;
+
+// [[ include("zone.h") ]]
+const civil_zone* zone_name_find(const std::string& zone_name) {
+  auto it = zone_name_cache.find(zone_name);
+
+  if (it != zone_name_cache.end()) {
+    return &it->second;
+  }
+
+  civil_zone zone;
+
+  if (!zone_name_parse_fixed(zone_name, zone)) {
+    try {
+      zone.p_time_zone = date::locate_zone(zone_name);
+    } catch (const std::runtime_error& error) {
+      return NULL;
+    }
+  }
+
+  it = zone_name_cache.emplace(zone_name, std::move(zone)).first;
+
+  return &it->second;
+}
+
+static const civil_zone* zone_name_load_try(const std::string& zone_name) {
+  const civil_zone* p_zone = zone_name_find(zone_name);
+
+  if (p_zone == NULL) {
+    civil_abort("'%s' not found in the timezone database.", zone_name.c_str());
+  }
+
+  return p_zone;
+}
+
+static const civil_zone* zone_name_load_current() {
+  const char* tz_env = std::getenv("TZ");
+  const bool tz_set = tz_env != NULL;
+
+  if (zone_name_current_cached &&
+      zone_name_current_tz_set == tz_set &&
+      (!tz_set || zone_name_current_tz == tz_env)) {
+    return zone_name_current_p_zone;
+  }
+
+  // We look up the local time zone using R's `Sys.timezone()`
+  // or the `TZ` envvar when an empty string is the input.
+  // This is consistent with lubridate.
+  std::string current_zone_name = zone_name_current();
+  const civil_zone* p_zone = zone_name_load_try(current_zone_name);
+
+  // `TZ=""` warns on every resolution, so it is never remembered
+  if (tz_set && strlen(tz_env) == 0) {
+    zone_name_current_cached = false;
+    return p_zone;
+  }
+
+  zone_name_current_cached = true;
+  zone_name_current_tz_set = tz_set;
+  zone_name_current_tz = tz_set ? tz_env : "";
+  zone_name_current_p_zone = p_zone;
+
+  return p_zone;
+}
 
 // [[ include("zone.h") ]]
-const date::time_zone* zone_name_load(const std::string& zone_name) {
+const civil_zone* zone_name_load(const std::string& zone_name) {
   if (zone_name.size() == 0) {
-    // We look up the local time zone using R's `Sys.timezone()`
-    // or the `TZ` envvar when an empty string is the input.
-    // This is consistent with lubridate.
-    std::string current_zone_name = zone_name_current();
-    return zone_name_load_try(current_zone_name);
+    return zone_name_load_current();
   } else {
     return zone_name_load_try(zone_name);
   }
 }
 
-const date::time_zone* zone_name_load_try(const std::string& zone_name) {
-  try {
-    return date::locate_zone(zone_name);
-  } catch (const std::runtime_error& error) {
-    civil_abort("'%s' not found in the timezone database.", zone_name.c_str());
+// -----------------------------------------------------------------------------
+
+/*
+ * Recognise zones that have had a single offset for all of time. These are
+ * the UTC and GMT zones of the tzdb and their links, the `Etc/GMT+N` zones,
+ * and numeric offsets such as `"+05:30"`. Abbreviations match what the tzdb
+ * would have given. Note that the `Etc/GMT+N` zones have POSIX style
+ * inverted signs, while numeric offsets are ISO 8601 style, so `"Etc/GMT-5"`
+ * and `"+05"` are the same zone.
+ */
+static bool zone_name_parse_fixed(const std::string& zone_name, civil_zone& zone) {
+  static const char* const utc_names[] = {
+    "UTC", "Etc/UTC", "UCT", "Etc/UCT", "Universal", "Etc/Universal", "Zulu", "Etc/Zulu"
+  };
+  static const char* const gmt_names[] = {
+    "GMT", "Etc/GMT", "GMT0", "Etc/GMT0", "GMT+0", "Etc/GMT+0", "GMT-0", "Etc/GMT-0",
+    "Greenwich", "Etc/Greenwich"
   };
+
+  for (const char* name : utc_names) {
+    if (zone_name == name) {
+      zone.abbrev = "UTC";
+      return true;
+    }
+  }
+
+  for (const char* name : gmt_names) {
+    if (zone_name == name) {
+      zone.abbrev = "GMT";
+      return true;
+    }
+  }
+
+  const char* p_name = zone_name.c_str();
+
+  if (zone_name.compare(0, 7, "Etc/GMT") == 0) {
+    // `Etc/GMT+N` for N in [1, 12] and `Etc/GMT-N` for N in [1, 14]
+    const char* p_hours = p_name + 8;
+    const char sign = p_name[7];
+
+    if (sign != '+' && sign != '-') {
+      return false;
+    }
+
+    int hours = 0;
+    const char* p = p_hours;
+
+    for (; *p != '\0' && p - p_hours < 2; ++p) {
+      if (*p < '0' || *p > '9') {
+        return false;
+      }
+      hours = hours * 10 + (*p - '0');
+    }
+
+    if (*p != '\0' || p == p_hours || *p_hours == '0') {
+      return false;
+    }
+    if (hours > (sign == '+' ? 12 : 14)) {
+      return false;
+    }
+
+    zone.offset = std::chrono::hours{sign == '+' ? -hours : hours};
+    zone.abbrev = zone_offset_abbrev(zone.offset);
+    return true;
+  }
+
+  std::chrono::seconds offset;
+
+  if (zone_name_parse_offset(p_name, offset)) {
+    zone.offset = offset;
+    zone.abbrev = zone_offset_abbrev(offset);
+    return true;
+  }
+
+  return false;
+}
+
+/*
+ * Parses `+HH`, `+HHMM`, or `+HH:MM`, or the same with a leading `-`
+ */
+static bool zone_name_parse_offset(const char* p_name, std::chrono::seconds& offset) {
+  const char sign = p_name[0];
+
+  if (sign != '+' && sign != '-') {
+    return false;
+  }
+
+  int digits[4];
+  int n = 0;
+  bool colon = false;
+  const char* p = p_name + 1;
+
+  for (; *p != '\0'; ++p) {
+    if (*p == ':' && n == 2 && !colon && p[1] != '\0') {
+      colon = true;
+      continue;
+    }
+    if (*p < '0' || *p > '9' || n == 4) {
+      return false;
+    }
+    digits[n++] = *p - '0';
+  }
+
+  if (n != 2 && n != 4) {
+    return false;
+  }
+
+  const int hours = digits[0] * 10 + digits[1];
+  const int minutes = (n == 4) ? digits[2] * 10 + digits[3] : 0;
+
+  if (hours > 23 || minutes > 59) {
+    return false;
+  }
+
+  offset = std::chrono::hours{hours} + std::chrono::minutes{minutes};
+
+  if (sign == '-') {
+    offset = -offset;
+  }
+
+  return true;
+}
+
+/*
+ * Abbreviation in the tzdb's numeric style, like `"+05"` or `"-0930"`
+ */
+static std::string zone_offset_abbrev(const std::chrono::seconds& offset) {
+  const bool negative = offset < std::chrono::seconds{0};
+  const int seconds = negative ? -offset.count() : offset.count();
+  const int hours = seconds / 3600;
+  const int minutes = seconds % 3600 / 60;
+
+  char buf[8];
+
+  if (minutes == 0) {
+    std::snprintf(buf, sizeof(buf), "%c%02d", negative ? '-' : '+', hours);
+  } else {
+    std::snprintf(buf, sizeof(buf), "%c%02d%02d", negative ? '-' : '+', hours, minutes);
+  }
+
+  return std::string(buf);
+}
+
+// -----------------------------------------------------------------------------
+
+static std::atomic<uint64_t> zone_lookup_sys_hits{0};
+static std::atomic<uint64_t> zone_lookup_sys_misses{0};
+static std::atomic<uint64_t> zone_lookup_local_hits{0};
+static std::atomic<uint64_t> zone_lookup_local_misses{0};
+
+zone_lookup::zone_lookup(const civil_zone* p_zone)
+  : p_zone_(p_zone),
+    sys_hits_(0),
+    sys_misses_(0),
+    local_hits_(0),
+    local_misses_(0) {
+  clear();
+}
+
+zone_lookup::~zone_lookup() {
+  zone_lookup_sys_hits += sys_hits_;
+  zone_lookup_sys_misses += sys_misses_;
+  zone_lookup_local_hits += local_hits_;
+  zone_lookup_local_misses += local_misses_;
+}
+
+void zone_lookup::set_zone(const civil_zone* p_zone) {
+  if (p_zone == p_zone_) {
+    return;
+  }
+
+  p_zone_ = p_zone;
+  clear();
+}
+
+void zone_lookup::clear() {
+#if !USE_OS_TZDB
+  sys_abbrev_ = date::time_zone::no_abbrev;
+#endif
+
+  if (p_zone_->p_time_zone != NULL) {
+    sys_info_ = date::sys_info{};
+    local_info_ = date::local_info{};
+    local_begin_ = date::local_seconds{};
+    local_end_ = date::local_seconds{};
+    return;
+  }
+
+  // A fixed offset zone is a single interval covering all of time, so every
+  // lookup is answered from the cache
+  sys_info_.begin = date::sys_seconds::min();
+  sys_info_.end = date::sys_seconds::max();
+  sys_info_.offset = p_zone_->offset;
+  sys_info_.save = std::chrono::minutes{0};
+  sys_info_.abbrev = p_zone_->abbrev;
+
+  local_info_.result = date::local_info::unique;
+  local_info_.first = sys_info_;
+  local_info_.second = date::sys_info{};
+
+  local_begin_ = date::local_seconds::min();
+  local_end_ = date::local_seconds::max();
+}
+
+/*
+ * Offsets of a block of instants in any order, see
+ * `date::time_zone::get_offsets()`. This skips the cached interval entirely,
+ * so it is meant for inputs that are not sorted. The OS tzdb has no block
+ * lookup, so there each instant gets its own `get_info()`.
+ */
+void zone_lookup::get_offsets(const date::sys_seconds* ssecs,
+                              r_ssize size,
+                              std::chrono::seconds* offsets) const {
+  if (p_zone_->p_time_zone == NULL) {
+    std::fill(offsets, offsets + size, p_zone_->offset);
+    return;
+  }
+
+#if USE_OS_TZDB
+  for (r_ssize i = 0; i < size; ++i) {
+    offsets[i] = p_zone_->p_time_zone->get_info(ssecs[i]).offset;
+  }
+#else
+  p_zone_->p_time_zone->get_offsets(ssecs, static_cast<std::size_t>(size), offsets);
+#endif
+}
+
+/*
+ * Whether every instant in `[first, last]` falls in a single interval of the
+ * zone, in which case `offset` is set to that interval's offset. Kernels use
+ * this on the range of their input to skip the per element lookups.
+ */
+bool zone_lookup::constant_offset(const date::sys_seconds& first,
+                                  const date::sys_seconds& last,
+                                  std::chrono::seconds& offset) {
+  const date::sys_info& info = get_info(first);
+
+  if (last >= info.end) {
+    return false;
+  }
+
+  offset = info.offset;
+  return true;
+}
+
+/*
+ * For local times, both ends must be unique and in the same interval.
+ * Ambiguous and nonexistent times only occur at the ends of an interval's
+ * local range, so everything between two such times is unique as well.
+ */
+bool zone_lookup::constant_offset(const date::local_seconds& first,
+                                  const date::local_seconds& last,
+                                  std::chrono::seconds& offset) {
+  const date::local_info& info_first = get_info(first);
+
+  if (info_first.result != date::local_info::unique) {
+    return false;
+  }
+
+  // Copy out before the next lookup replaces the cached info
+  const date::sys_seconds begin = info_first.first.begin;
+  const std::chrono::seconds first_offset = info_first.first.offset;
+
+  const date::local_info& info_last = get_info(last);
+
+  if (info_last.result != date::local_info::unique || info_last.first.begin != begin) {
+    return false;
+  }
+
+  offset = first_offset;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+zone_lookups::zone_lookups(const cpp11::strings& zone, r_ssize size) {
+  const r_ssize zone_size = zone.size();
+
+  if (zone_size == 0) {
+    civil_abort("`zone` size must be at least 1.");
+  }
+  if (zone_size != 1 && zone_size != size) {
+    civil_abort("`zone` must be size 1 or the same size as the input.");
+  }
+
+  // Element strings are interned by R, so their `CHARSXP` identifies them
+  std::unordered_map<SEXP, int> ids;
+  std::vector<int> elt_ids(zone_size);
+
+  for (r_ssize i = 0; i < zone_size; ++i) {
+    SEXP elt_zone = STRING_ELT(zone, i);
+    auto it = ids.find(elt_zone);
+
+    if (it != ids.end()) {
+      elt_ids[i] = it->second;
+      continue;
+    }
+
+    std::string zone_name(cpp11::r_string{elt_zone});
+    const civil_zone* p_zone = zone_name_load(zone_name);
+
+    const int id = static_cast<int>(lookups_.size());
+    lookups_.emplace_back(p_zone);
+    names_.push_back((zone_name.size() == 0) ? zone_name_current() : zone_name);
+
+    ids.emplace(elt_zone, id);
+    elt_ids[i] = id;
+  }
+
+  if (lookups_.size() > 1) {
+    ids_ = std::move(elt_ids);
+  }
+}
+
+/*
+ * Hits and misses of every `zone_lookup` destroyed so far in this session,
+ * optionally resetting the counts afterwards
+ */
+[[cpp11::register]]
+cpp11::writable::doubles zone_lookup_counts_cpp(const bool& reset) {
+  cpp11::writable::doubles out({
+    static_cast<double>(zone_lookup_sys_hits),
+    static_cast<double>(zone_lookup_sys_misses),
+    static_cast<double>(zone_lookup_local_hits),
+    static_cast<double>(zone_lookup_local_misses)
+  });
+
+  out.names() = {"sys_hits", "sys_misses", "local_hits", "local_misses"};
+
+  if (reset) {
+    zone_lookup_sys_hits = 0;
+    zone_lookup_sys_misses = 0;
+    zone_lookup_local_hits = 0;
+    zone_lookup_local_misses = 0;
+  }
+
+  return out;
+}
+
+/*
+ * Turns the local time index of the zones' expanded tables on or off, so that
+ * tests can reach the search it falls back to. The OS tzdb has no expanded
+ * tables, so there this does nothing.
+ */
+[[cpp11::register]]
+void zone_set_local_index_cpp(const bool& enabled) {
+#if !USE_OS_TZDB
+  date::set_local_index(enabled);
+#endif
 }
 
+// -----------------------------------------------------------------------------
+
 static std::string zone_name_system();
 
 // [[ include("zone.h") ]]
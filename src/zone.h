@@ -2,14 +2,223 @@
 #define CIVIL_ZONE_H
 
 #include "civil.h"
+#include <deque>
+#include <vector>
 
 cpp11::writable::strings zone_standardize(const cpp11::strings& zone);
 
 std::string zone_name_current();
 
+/*
+ * A time zone loaded by name. Zones that have had a single offset for all of
+ * time, like `"UTC"`, `"Etc/GMT+5"`, or a numeric offset like `"+05:30"`, are
+ * recognised from their name alone and never touch the tzdb. For those,
+ * `p_time_zone` is `NULL` and `offset` and `abbrev` describe the zone.
+ */
+struct civil_zone {
+  const date::time_zone* p_time_zone = NULL;
+  std::chrono::seconds offset{0};
+  std::string abbrev;
+};
+
 /*
  * Load a time zone name, or throw an R error if it can't be loaded
  */
-const date::time_zone* zone_name_load(const std::string& zone_name);
+const civil_zone* zone_name_load(const std::string& zone_name);
+
+/*
+ * Load a non-empty time zone name, or return `NULL` if it can't be loaded
+ */
+const civil_zone* zone_name_find(const std::string& zone_name);
+
+// -----------------------------------------------------------------------------
+
+/*
+ * A per-kernel view of a time zone that remembers the last interval it looked
+ * up. Inputs to the conversion kernels tend to be clustered in time, so
+ * successive elements usually fall in the same interval and can be answered
+ * without going back to the tzdb.
+ *
+ * Only unique local lookups are cached, and the cached local range is pulled
+ * in by a day on each side of the interval. Nothing in that range can be
+ * affected by the gap or overlap at either end, so the cached result is
+ * exactly what `get_info()` would have returned.
+ *
+ * Fixed offset zones are set up as one cached interval covering all of time,
+ * so their lookups never leave the cache.
+ *
+ * With the embedded tzdb, abbreviations are tracked by their id in the zone's
+ * interned table, see `abbrev()`.
+ *
+ * Hits and misses are added to process wide counters when the lookup is
+ * destroyed, see `zone_lookup_counts_cpp()`.
+ */
+class zone_lookup {
+public:
+  explicit zone_lookup(const civil_zone* p_zone);
+  ~zone_lookup();
+
+  zone_lookup(const zone_lookup&) = delete;
+  zone_lookup& operator=(const zone_lookup&) = delete;
+
+  const civil_zone* zone() const;
+  void set_zone(const civil_zone* p_zone);
+
+  const date::sys_info& get_info(const date::sys_seconds& ssec);
+  const date::local_info& get_info(const date::local_seconds& lsec);
+
+  const std::string& abbrev() const;
+
+  void get_offsets(const date::sys_seconds* ssecs,
+                   r_ssize size,
+                   std::chrono::seconds* offsets) const;
+
+  bool constant_offset(const date::sys_seconds& first,
+                       const date::sys_seconds& last,
+                       std::chrono::seconds& offset);
+  bool constant_offset(const date::local_seconds& first,
+                       const date::local_seconds& last,
+                       std::chrono::seconds& offset);
+
+private:
+  const civil_zone* p_zone_;
+
+  date::sys_info sys_info_;
+#if !USE_OS_TZDB
+  std::uint32_t sys_abbrev_;
+#endif
+  date::local_info local_info_;
+  date::local_seconds local_begin_;
+  date::local_seconds local_end_;
+
+  uint64_t sys_hits_;
+  uint64_t sys_misses_;
+  uint64_t local_hits_;
+  uint64_t local_misses_;
+
+  void clear();
+};
+
+inline const civil_zone* zone_lookup::zone() const {
+  return p_zone_;
+}
+
+/*
+ * The abbreviation of the interval found by the last sys lookup. It refers to
+ * the zone's interned copy where there is one, so it stays valid after the
+ * next lookup and copying it out is never needed. The OS tzdb has no interned
+ * table, so there it is always the copy in `sys_info_`.
+ */
+inline const std::string& zone_lookup::abbrev() const {
+#if !USE_OS_TZDB
+  if (sys_abbrev_ != date::time_zone::no_abbrev) {
+    return p_zone_->p_time_zone->abbrev(sys_abbrev_);
+  }
+#endif
+
+  return sys_info_.abbrev;
+}
+
+inline const date::sys_info& zone_lookup::get_info(const date::sys_seconds& ssec) {
+  if (sys_info_.begin <= ssec && ssec < sys_info_.end) {
+    ++sys_hits_;
+    return sys_info_;
+  }
+
+  if (p_zone_->p_time_zone == NULL) {
+    // Only the very end of time misses for a fixed offset zone
+    ++sys_hits_;
+    return sys_info_;
+  }
+
+  ++sys_misses_;
+
+#if USE_OS_TZDB
+  sys_info_ = p_zone_->p_time_zone->get_info(ssec);
+#else
+  // Inside the zone's expanded table the abbreviation comes back as an id
+  // rather than a string, so `sys_info_.abbrev` is left empty and only
+  // `abbrev()` has it
+  sys_info_ = p_zone_->p_time_zone->get_info(ssec, sys_abbrev_);
+#endif
+
+  return sys_info_;
+}
+
+inline const date::local_info& zone_lookup::get_info(const date::local_seconds& lsec) {
+  if (local_begin_ <= lsec && lsec < local_end_) {
+    ++local_hits_;
+    return local_info_;
+  }
+
+  if (p_zone_->p_time_zone == NULL) {
+    ++local_hits_;
+    return local_info_;
+  }
+
+  ++local_misses_;
+  local_info_ = p_zone_->p_time_zone->get_info(lsec);
+
+  if (local_info_.result == date::local_info::unique) {
+    const date::sys_info& info = local_info_.first;
+    local_begin_ = date::local_seconds{(info.begin + info.offset).time_since_epoch()} + date::days{1};
+    local_end_ = date::local_seconds{(info.end + info.offset).time_since_epoch()} - date::days{1};
+  } else {
+    local_begin_ = date::local_seconds{};
+    local_end_ = date::local_seconds{};
+  }
+
+  return local_info_;
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * The lookups for a kernel whose `zone` is either a single zone name, or one
+ * name per element of the input. Each distinct name is loaded once and gets
+ * its own `zone_lookup`, and every element is tagged with the id of its zone.
+ * Elements of the same zone then share that zone's cached interval, no matter
+ * how the zones are interleaved.
+ *
+ * When there is only one distinct zone, `is_scalar()` is true and kernels can
+ * use `scalar()` directly, including for the constant offset fast paths.
+ */
+class zone_lookups {
+public:
+  zone_lookups(const cpp11::strings& zone, r_ssize size);
+
+  zone_lookups(const zone_lookups&) = delete;
+  zone_lookups& operator=(const zone_lookups&) = delete;
+
+  bool is_scalar() const;
+  zone_lookup& scalar();
+
+  zone_lookup& operator[](r_ssize i);
+  const std::string& name(r_ssize i) const;
+
+private:
+  std::deque<zone_lookup> lookups_;
+  std::vector<std::string> names_;
+  std::vector<int> ids_;
+};
+
+inline bool zone_lookups::is_scalar() const {
+  return ids_.empty();
+}
+
+inline zone_lookup& zone_lookups::scalar() {
+  return lookups_.front();
+}
+
+inline zone_lookup& zone_lookups::operator[](r_ssize i) {
+  return ids_.empty() ? lookups_.front() : lookups_[ids_[i]];
+}
+
+/*
+ * The name of the zone of element `i`, with `""` resolved to the current zone
+ */
+inline const std::string& zone_lookups::name(r_ssize i) const {
+  return ids_.empty() ? names_.front() : names_[ids_[i]];
+}
 
 #endif